@@ -0,0 +1,183 @@
+#include "example.h"
+#include "trochili.h"
+
+#if (EVB_EXAMPLE == CH5_RWLOCK_EXAMPLE1)
+
+/*
+ * 写线程等待写锁超时的例子:
+ * (1) 持有者线程获得读锁后保持2秒;
+ * (2) 写线程以时限方式申请写锁，时限0.5秒，此后新的读操作都要排在写线程之后;
+ * (3) 读线程在写线程之后申请读锁，被阻塞;
+ * (4) 写线程超时退出后，读线程应该立即获得读锁，而不是等到持有者线程释放读锁
+ */
+
+/* 用户线程参数 */
+#define THREAD_STACK_BYTES      (512)
+#define THREAD_HOLDER_PRIORITY  (6)
+#define THREAD_WRITER_PRIORITY  (5)
+#define THREAD_READER_PRIORITY  (4)
+#define THREAD_SLICE            (20)
+
+/* 用户线程栈定义 */
+static TBase32 ThreadHolderStack[THREAD_STACK_BYTES/4];
+static TBase32 ThreadWriterStack[THREAD_STACK_BYTES/4];
+static TBase32 ThreadReaderStack[THREAD_STACK_BYTES/4];
+
+/* 用户线程定义 */
+static TThread ThreadHolder;
+static TThread ThreadWriter;
+static TThread ThreadReader;
+
+/* 用户读写锁定义 */
+static TRwLock LedRwLock;
+
+/* 持有者线程是否仍然持有读锁 */
+static volatile TBool HolderReading = eFalse;
+
+
+/* 持有者线程的主函数 */
+static void ThreadHolderEntry(TArgument arg)
+{
+    TState state;
+    TError error;
+
+    /* 获得读锁并保持2秒 */
+    state = TclReadLock(&LedRwLock, TCLO_IPC_WAIT, 0U, &error);
+    TCLM_ASSERT((state == eSuccess), "");
+    TCLM_ASSERT((error == TCLE_IPC_NONE), "");
+    HolderReading = eTrue;
+
+    state = TclDelayThread(TCLM_SEC2TICKS(2), &error);
+    TCLM_ASSERT((state == eSuccess), "");
+
+    HolderReading = eFalse;
+    state = TclUnlockRwLock(&LedRwLock, &error);
+    TCLM_ASSERT((state == eSuccess), "");
+    TCLM_ASSERT((error == TCLE_IPC_NONE), "");
+
+    while (eTrue)
+    {
+        state = TclDelayThread(TCLM_SEC2TICKS(1), &error);
+    }
+}
+
+
+/* 写线程的主函数 */
+static void ThreadWriterEntry(TArgument arg)
+{
+    TState state;
+    TError error;
+
+    /* 等持有者线程获得读锁后再申请写锁，读锁一直被持有，写线程必然超时 */
+    state = TclDelayThread(TCLM_MLS2TICKS(100), &error);
+    TCLM_ASSERT((state == eSuccess), "");
+
+    state = TclWriteLock(&LedRwLock, TCLO_IPC_WAIT | TCLO_IPC_TIMEO,
+                         TCLM_MLS2TICKS(500), &error);
+    TCLM_ASSERT((state == eFailure), "");
+    TCLM_ASSERT((error == TCLE_IPC_TIMEO), "");
+
+    while (eTrue)
+    {
+        state = TclDelayThread(TCLM_SEC2TICKS(1), &error);
+    }
+}
+
+
+/* 读线程的主函数 */
+static void ThreadReaderEntry(TArgument arg)
+{
+    TState state;
+    TError error;
+
+    /* 在写线程之后申请读锁，被写线程挡住 */
+    state = TclDelayThread(TCLM_MLS2TICKS(200), &error);
+    TCLM_ASSERT((state == eSuccess), "");
+
+    state = TclReadLock(&LedRwLock, TCLO_IPC_WAIT | TCLO_IPC_TIMEO,
+                        TCLM_SEC2TICKS(1), &error);
+
+    /* 写线程超时后，读线程必须在持有者线程释放读锁之前获得读锁 */
+    TCLM_ASSERT((state == eSuccess), "");
+    TCLM_ASSERT((error == TCLE_IPC_NONE), "");
+    TCLM_ASSERT((HolderReading == eTrue), "");
+
+    state = TclUnlockRwLock(&LedRwLock, &error);
+    TCLM_ASSERT((state == eSuccess), "");
+    TCLM_ASSERT((error == TCLE_IPC_NONE), "");
+
+    /* 测试通过，Led闪烁 */
+    while (eTrue)
+    {
+        EvbLedControl(LED1, LED_ON);
+        state = TclDelayThread(TCLM_SEC2TICKS(1), &error);
+        EvbLedControl(LED1, LED_OFF);
+        state = TclDelayThread(TCLM_SEC2TICKS(1), &error);
+    }
+}
+
+
+/* 用户应用入口函数 */
+static void AppSetupEntry(void)
+{
+    TState state;
+    TError error;
+
+    /* 初始化读写锁 */
+    state = TclCreateRwLock(&LedRwLock, "led rwlock", TCLP_IPC_DEFAULT, &error);
+    TCLM_ASSERT((state == eSuccess), "");
+    TCLM_ASSERT((error == TCLE_IPC_NONE), "");
+
+    /* 初始化持有者线程 */
+    state = TclCreateThread(&ThreadHolder, "holder thread",
+                            &ThreadHolderEntry, (TArgument)0,
+                            ThreadHolderStack, THREAD_STACK_BYTES,
+                            THREAD_HOLDER_PRIORITY, THREAD_SLICE,
+                            &error);
+    TCLM_ASSERT((state == eSuccess), "");
+    TCLM_ASSERT((error == TCLE_THREAD_NONE), "");
+
+    /* 初始化写线程 */
+    state = TclCreateThread(&ThreadWriter, "writer thread",
+                            &ThreadWriterEntry, (TArgument)0,
+                            ThreadWriterStack, THREAD_STACK_BYTES,
+                            THREAD_WRITER_PRIORITY, THREAD_SLICE,
+                            &error);
+    TCLM_ASSERT((state == eSuccess), "");
+    TCLM_ASSERT((error == TCLE_THREAD_NONE), "");
+
+    /* 初始化读线程 */
+    state = TclCreateThread(&ThreadReader, "reader thread",
+                            &ThreadReaderEntry, (TArgument)0,
+                            ThreadReaderStack, THREAD_STACK_BYTES,
+                            THREAD_READER_PRIORITY, THREAD_SLICE,
+                            &error);
+    TCLM_ASSERT((state == eSuccess), "");
+    TCLM_ASSERT((error == TCLE_THREAD_NONE), "");
+
+    /* 激活全部线程 */
+    state = TclActivateThread(&ThreadHolder, &error);
+    TCLM_ASSERT((state == eSuccess), "");
+    TCLM_ASSERT((error == TCLE_THREAD_NONE), "");
+
+    state = TclActivateThread(&ThreadWriter, &error);
+    TCLM_ASSERT((state == eSuccess), "");
+    TCLM_ASSERT((error == TCLE_THREAD_NONE), "");
+
+    state = TclActivateThread(&ThreadReader, &error);
+    TCLM_ASSERT((state == eSuccess), "");
+    TCLM_ASSERT((error == TCLE_THREAD_NONE), "");
+}
+
+
+/* 处理器BOOT之后会调用main函数，必须提供 */
+int main(void)
+{
+    /* 注册各个内核函数,启动内核 */
+    TclStartKernel(&AppSetupEntry,
+                   &CpuSetupEntry,
+                   &EvbSetupEntry,
+                   &EvbTraceEntry);
+    return 1;
+}
+#endif
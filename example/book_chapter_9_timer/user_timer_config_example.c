@@ -77,11 +77,11 @@ static TBitMask EvbKeyISR(TArgument data)
         mls2 = (mls2 > 2000)? 2000:mls2;
 
         /* 配置用户定时器 */
-        state = TclConfigTimer(&Led1Timer, TCLM_MLS2TICKS(mls1), (TPriority)5, &error);
+        state = TclConfigTimer(&Led1Timer, TCLM_MLS2TICKS(mls1), (TPriority)5, 0U, &error);
         TCLM_ASSERT((state == eSuccess), "");
         TCLM_ASSERT((error == TCLE_TIMER_NONE), "");
 
-        state = TclConfigTimer(&Led2Timer, TCLM_MLS2TICKS(mls2), (TPriority)5, &error);
+        state = TclConfigTimer(&Led2Timer, TCLM_MLS2TICKS(mls2), (TPriority)5, 0U, &error);
         TCLM_ASSERT((state == eSuccess), "");
         TCLM_ASSERT((error == TCLE_TIMER_NONE), "");
 
@@ -113,11 +113,11 @@ static TBitMask EvbKeyISR(TArgument data)
         mls2 = (mls2 < 100)? 100:mls2;
 
         /* 配置用户定时器 */
-        state = TclConfigTimer(&Led1Timer, TCLM_MLS2TICKS(mls1), (TPriority)5, &error);
+        state = TclConfigTimer(&Led1Timer, TCLM_MLS2TICKS(mls1), (TPriority)5, 0U, &error);
         TCLM_ASSERT((state == eSuccess), "");
         TCLM_ASSERT((error == TCLE_TIMER_NONE), "");
 
-        state = TclConfigTimer(&Led2Timer, TCLM_MLS2TICKS(mls2), (TPriority)5, &error);
+        state = TclConfigTimer(&Led2Timer, TCLM_MLS2TICKS(mls2), (TPriority)5, 0U, &error);
         TCLM_ASSERT((state == eSuccess), "");
         TCLM_ASSERT((error == TCLE_TIMER_NONE), "");
 
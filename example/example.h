@@ -23,6 +23,7 @@
 #define CH5_MUTEX_EXAMPLE3         (52)       /* FLUSH                */
 #define CH5_MUTEX_EXAMPLE4         (54)       /* DELETE               */
 #define CH5_MUTEX_EXAMPLE5         (56)       /* ABORT                */
+#define CH5_RWLOCK_EXAMPLE1        (57)       /* WRITER TIMEOUT       */
 
 #define CH6_MAILBOX_EXAMPLE1       (61)       /* 异步单向邮件收发     */
 #define CH6_MAILBOX_EXAMPLE2       (62)       /* KEY ISR              */
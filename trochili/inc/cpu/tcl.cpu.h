@@ -7,6 +7,7 @@
 #define _TCLC_CPU_H
 
 #include "tcl.types.h"
+#include "tcl.config.h"
 
 extern void CpuSetupEntry(void);
 extern void CpuStartTickClock(void);
@@ -20,6 +21,24 @@ extern void CpuEnterCritical(TReg32* pValue);
 extern void CpuLeaveCritical(TReg32 value);
 extern void CpuLoadRootThread(void);
 extern TPriority CpuCalcHiPRIO(TBase32 data);
+extern TBase32 CpuGetCycleCount(void);
+extern TBase32 CpuGetTickCycles(void);
+
+#if ((TCLC_TIMER_ENABLE) && (TCLC_TIMER_HRES_ENABLE))
+extern void CpuStartHrAlarm(TBase32 usecs);
+extern void CpuStopHrAlarm(void);
+#endif
+
+#if (TCLC_KERNEL_PROFILE_ENABLE)
+/* 获得函数返回地址，用于记录临界区调用者 */
+#define CpuGetCallerAddr()      ((TAddr32)__return_address())
+
+/* 开启内核性能统计后，临界区操作由内核统计函数代理完成 */
+extern void xKernelEnterCritical(TReg32* pValue);
+extern void xKernelLeaveCritical(TReg32 value);
+#define CpuEnterCritical(pValue) xKernelEnterCritical(pValue)
+#define CpuLeaveCritical(value)  xKernelLeaveCritical(value)
+#endif
 
 #endif /* _TCLC_CPU_H */
 
@@ -0,0 +1,51 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#ifndef _TCL_BARRIER_H
+#define _TCL_BARRIER_H
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.object.h"
+#include "tcl.ipc.h"
+#include "tcl.thread.h"
+
+#if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_BARRIER_ENABLE))
+
+/* 循环屏障结构定义，Parties个线程全部到达后一起放行，然后屏障自动进入下一轮 */
+struct BarrierDef
+{
+    TProperty Property;         /* 队列中线程的调度策略等属性配置     */
+    TBase32   Parties;          /* 每一轮需要到达屏障的线程数目       */
+    TBase32   Arrived;          /* 本轮已经到达屏障的线程数目         */
+    TBase32   Phase;            /* 屏障已经放行的轮数                 */
+    TIpcQueue Queue;            /* 屏障的线程阻塞队列                 */
+    TObject   Object;
+};
+typedef struct BarrierDef TBarrier;
+
+/* 倒计数门闩结构定义，计数减到0后门闩一直保持打开 */
+struct LatchDef
+{
+    TProperty Property;         /* 队列中线程的调度策略等属性配置     */
+    TBase32   Count;            /* 门闩的当前计数                     */
+    TIpcQueue Queue;            /* 门闩的线程阻塞队列                 */
+    TObject   Object;
+};
+typedef struct LatchDef TLatch;
+
+extern TState xBarrierCreate(TBarrier* pBarrier, TChar* pName, TBase32 parties, TProperty property,
+                             TError* pError);
+extern TState xBarrierDelete(TBarrier* pBarrier, TError* pError);
+extern TState xBarrierWait(TBarrier* pBarrier, TOption option, TTimeTick timeo, TError* pError);
+extern TState xLatchCreate(TLatch* pLatch, TChar* pName, TBase32 count, TProperty property,
+                           TError* pError);
+extern TState xLatchDelete(TLatch* pLatch, TError* pError);
+extern TState xLatchCountDown(TLatch* pLatch, TError* pError);
+extern TState xLatchWait(TLatch* pLatch, TOption option, TTimeTick timeo, TError* pError);
+#endif
+
+#endif /*_TCL_BARRIER_H*/
+
@@ -0,0 +1,37 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#ifndef _TCL_CONDVAR_H
+#define _TCL_CONDVAR_H
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.object.h"
+#include "tcl.ipc.h"
+#include "tcl.thread.h"
+#include "tcl.mutex.h"
+
+#if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_MUTEX_ENABLE)&&(TCLC_IPC_CONDVAR_ENABLE))
+
+/* 条件变量结构定义，条件变量在初始化时和一个互斥量绑定 */
+struct CondVarDef
+{
+    TProperty Property;         /* 队列中线程的调度策略等属性配置     */
+    TMutex*   Mutex;            /* 条件变量绑定的互斥量               */
+    TIpcQueue Queue;            /* 条件变量的线程阻塞队列             */
+    TObject   Object;
+};
+typedef struct CondVarDef TCondVar;
+
+extern TState xCondVarCreate(TCondVar* pCondVar, TChar* pName, TMutex* pMutex, TProperty property,
+                             TError* pError);
+extern TState xCondVarDelete(TCondVar* pCondVar, TError* pError);
+extern TState xCondVarWait(TCondVar* pCondVar, TOption option, TTimeTick timeo, TError* pError);
+extern TState xCondVarSignal(TCondVar* pCondVar, TError* pError);
+extern TState xCondVarBroadcast(TCondVar* pCondVar, TError* pError);
+#endif
+
+#endif /*_TCL_CONDVAR_H*/
+
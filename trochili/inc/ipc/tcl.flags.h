@@ -31,6 +31,42 @@ extern TState xFlagsSend(TFlags* pFlags, TBitMask pattern, TError* pError);
 extern TState xFlagsReceive(TFlags* pFlags, TBitMask* pPattern,
                             TOption option, TTimeTick timeo, TError* pError);
 
+#if (TCLC_IPC_FLAGS64_ENABLE)
+/* 64位事件标记的等待桶数目，前64个桶按触发位索引，最后一个桶保存多位OR等待 */
+#define FLAGS64_BUCKETS        (65U)
+#define FLAGS64_SCATTER        (64U)
+
+/* 64位事件标记等待者结构定义，线程阻塞期间保存在线程栈上 */
+struct Flags64WaiterDef
+{
+    TIpcContext Context;                  /* IPC阻塞信息，必须是首成员  */
+    TLinkNode   Node;                     /* 线程所在等待桶的链表节点   */
+    TBase32     Ticket;                   /* 线程开始等待的顺序号       */
+};
+typedef struct Flags64WaiterDef TFlags64Waiter;
+
+/* 64位事件标记结构定义 */
+struct Flags64Def
+{
+    TProperty  Property;                  /* 线程的调度策略等属性配置   */
+    TBitMask64 Value;                     /* 事件标记的当前事件组       */
+    TBitMask64 BucketMask;                /* 非空的等待桶标记           */
+    TBase32    Tickets;                   /* 等待顺序号计数器           */
+    TLinkNode* Buckets[FLAGS64_BUCKETS];  /* 按触发位索引的等待线程     */
+    TIpcQueue  Queue;                     /* 事件标记的线程阻塞队列     */
+    TObject    Object;
+};
+typedef struct Flags64Def TFlags64;
+
+extern TState xFlags64Create(TFlags64* pFlags, TChar* pName, TProperty property, TError* pError);
+extern TState xFlags64Delete(TFlags64* pFlags, TError* pError);
+extern TState xFlags64Reset(TFlags64* pFlags, TError* pError);
+extern TState xFlags64Flush(TFlags64* pFlags, TError* pError);
+extern TState xFlags64Send(TFlags64* pFlags, TBitMask64 pattern, TError* pError);
+extern TState xFlags64Receive(TFlags64* pFlags, TBitMask64* pPattern,
+                              TOption option, TTimeTick timeo, TError* pError);
+#endif
+
 #endif
 
 #endif /* _TCL_FLAGS_H */
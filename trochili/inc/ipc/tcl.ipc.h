@@ -12,12 +12,21 @@
 
 #if (TCLC_IPC_ENABLE)
 
-/* IPC线程阻塞队列结构定义 */
+/*
+ * IPC线程阻塞队列结构定义，开启索引后优先级队列仍然是一个按照优先级排序的循环链表，
+ * 另外参考内核线程队列记录每个优先级分组的第一个节点和非空优先级掩码，使得插入和移出都是O(1)
+ */
 struct IpcBlockedQueueDef
 {
     TProperty* Property;                                /* 线程阻塞队列属性                          */
     TLinkNode*  PrimaryHandle;                           /* 队列中基本线程分队列                      */
     TLinkNode*  AuxiliaryHandle;                         /* 队列中辅助线程分队列                      */
+#if (TCLC_IPC_QUEUE_O1_ENABLE)
+    TBitMask    PrimaryMask;                             /* 基本线程分队列中的优先级掩码              */
+    TBitMask    AuxiliaryMask;                           /* 辅助线程分队列中的优先级掩码              */
+    TLinkNode*  PrimaryHeads[TCLC_PRIORITY_NUM];         /* 基本线程分队列中各优先级分组的首节点      */
+    TLinkNode*  AuxiliaryHeads[TCLC_PRIORITY_NUM];       /* 辅助线程分队列中各优先级分组的首节点      */
+#endif
 };
 typedef struct IpcBlockedQueueDef TIpcQueue;
 
@@ -44,6 +53,7 @@ typedef struct IpcBlockedQueueDef TIpcQueue;
 #define IPC_PROP_READY           (TProperty)(0x1<<0)    /* IPC对象已经被初始化                       */
 #define IPC_PROP_PREEMP_AUXIQ    (TProperty)(0x1<<1)    /* 辅助线程阻塞队列采用优先级调度方案        */
 #define IPC_PROP_PREEMP_PRIMIQ   (TProperty)(0x1<<2)    /* 基本线程阻塞队列采用优先级调度方案        */
+#define IPC_PROP_OVERWRITE       (TProperty)(0x1<<3)    /* 队列满时新数据覆盖最早的数据              */
 #define IPC_PROP_AUXIQ_AVAIL     (TProperty)(0x1<<17)   /* 辅助线程阻塞队列里存在被阻塞的线程        */
 #define IPC_PROP_PRIMQ_AVAIL     (TProperty)(0x1<<18)   /* 基本线程阻塞队列里存在被阻塞的线程        */
 
@@ -58,6 +68,14 @@ typedef struct IpcBlockedQueueDef TIpcQueue;
 #define IPC_USER_MBOX_PROP      (IPC_PROP_PREEMP_PRIMIQ | IPC_PROP_PREEMP_AUXIQ)
 #define IPC_USER_MQUE_PROP      (IPC_PROP_PREEMP_PRIMIQ | IPC_PROP_PREEMP_AUXIQ)
 #define IPC_USER_FLAG_PROP      (IPC_PROP_PREEMP_PRIMIQ)
+#define IPC_USER_RWLOCK_PROP    (IPC_PROP_PREEMP_PRIMIQ | IPC_PROP_PREEMP_AUXIQ)
+#define IPC_USER_CONDVAR_PROP   (IPC_PROP_PREEMP_PRIMIQ)
+#define IPC_USER_BARRIER_PROP   (IPC_PROP_PREEMP_PRIMIQ)
+#define IPC_USER_LATCH_PROP     (IPC_PROP_PREEMP_PRIMIQ)
+#define IPC_USER_STREAM_PROP    (IPC_PROP_DEFAULT)
+#define IPC_USER_PMQUE_PROP     (IPC_PROP_PREEMP_PRIMIQ)
+#define IPC_USER_MMBOX_PROP     (IPC_PROP_PREEMP_PRIMIQ | IPC_PROP_OVERWRITE)
+#define IPC_USER_TOPIC_PROP     (IPC_PROP_PREEMP_PRIMIQ | IPC_PROP_OVERWRITE)
 
 /* 线程IPC选项，内核代码使用 */
 #define IPC_OPT_DEFAULT               (TOption)(0x0)
@@ -73,16 +91,32 @@ typedef struct IpcBlockedQueueDef TIpcQueue;
 #define IPC_OPT_MAILBOX          (TOption)(0x1<<18)      /* 标记线程阻塞在邮箱的线程阻塞队列中       */
 #define IPC_OPT_MSGQUEUE         (TOption)(0x1<<19)      /* 标记线程阻塞在消息队列的线程阻塞队列中   */
 #define IPC_OPT_FLAGS            (TOption)(0x1<<20)      /* 标记线程阻塞在事件标记的线程阻塞队列中   */
+#define IPC_OPT_RWLOCK           (TOption)(0x1<<21)      /* 标记线程阻塞在读写锁的线程阻塞队列中     */
+#define IPC_OPT_CONDVAR          (TOption)(0x1<<22)      /* 标记线程阻塞在条件变量的线程阻塞队列中   */
 
 #define IPC_OPT_USE_AUXIQ        (TOption)(0x1<<23)      /* 标记线程在线程阻塞队列的辅助队列中       */
 #define IPC_OPT_READ_DATA        (TOption)(0x1<<24)      /* 接收邮件或者消息                         */
 #define IPC_OPT_WRITE_DATA       (TOption)(0x1<<25)      /* 发送邮件或者消息                         */
+#define IPC_OPT_BARRIER          (TOption)(0x1<<26)      /* 标记线程阻塞在屏障的线程阻塞队列中       */
+#define IPC_OPT_LATCH            (TOption)(0x1<<27)      /* 标记线程阻塞在门闩的线程阻塞队列中       */
+#define IPC_OPT_STREAM           (TOption)(0x1<<28)      /* 标记线程阻塞在字节流缓冲区的阻塞队列中   */
+#define IPC_OPT_PMQUEUE          (TOption)(0x1<<29)      /* 标记线程阻塞在多优先级消息队列中         */
+#define IPC_OPT_TOPIC            (TOption)(0x1<<30)      /* 标记线程阻塞在主题订阅者的阻塞队列中     */
 
 #define IPC_USER_SEMAPHORE_OPTION  (IPC_OPT_WAIT|IPC_OPT_TIMEO)
 #define IPC_USER_MUTEX_OPTION      (IPC_OPT_WAIT|IPC_OPT_TIMEO)
 #define IPC_USER_MBOX_OPTION       (IPC_OPT_WAIT|IPC_OPT_TIMEO|IPC_OPT_UARGENT)
 #define IPC_USER_MSGQ_OPTION       (IPC_OPT_WAIT|IPC_OPT_TIMEO|IPC_OPT_UARGENT)
 #define IPC_USER_FLAG_OPTION       (IPC_OPT_WAIT|IPC_OPT_TIMEO|IPC_OPT_AND|IPC_OPT_OR|IPC_OPT_CONSUME)
+#define IPC_USER_RWLOCK_OPTION     (IPC_OPT_WAIT|IPC_OPT_TIMEO)
+#define IPC_USER_CONDVAR_OPTION    (IPC_OPT_WAIT|IPC_OPT_TIMEO)
+#define IPC_USER_BARRIER_OPTION    (IPC_OPT_WAIT|IPC_OPT_TIMEO)
+#define IPC_USER_LATCH_OPTION      (IPC_OPT_WAIT|IPC_OPT_TIMEO)
+#define IPC_USER_STREAM_OPTION     (IPC_OPT_WAIT|IPC_OPT_TIMEO)
+#define IPC_USER_PMQUE_OPTION      (IPC_OPT_WAIT|IPC_OPT_TIMEO)
+#define IPC_USER_MMBOX_OPTION      (IPC_OPT_WAIT|IPC_OPT_TIMEO)
+#define IPC_USER_TOPIC_OPTION      (IPC_OPT_WAIT|IPC_OPT_TIMEO)
+#define IPC_USER_LOAN_OPTION       (IPC_OPT_WAIT|IPC_OPT_TIMEO)
 
 /* NOTE: not compliant MISRA2004 18.4: Unions shall not be used. */
 union IpcDataDef
@@ -93,6 +127,18 @@ union IpcDataDef
 };
 typedef union IpcDataDef TIpcData;
 
+struct IpcContextDef;
+
+/*
+ * 线程被解除阻塞时的回调函数类型定义，在临界区内、线程离开阻塞队列之后立即执行，
+ * IPC对象用它撤销线程等待期间登记在对象中的信息，避免线程超时或者被强制唤醒之后到真正运行之前
+ * 这段时间里对象仍然把它当作等待者
+ */
+typedef void (*TIpcWakeup)(struct IpcContextDef* pContext, TState state);
+
+/* 阻塞线程的优先级被修改时的回调函数类型定义，IPC对象用它调整线程在对象内部等待队列中的位置 */
+typedef void (*TIpcReorder)(struct IpcContextDef* pContext);
+
 /* 线程用于记录IPC对象的详细信息的记录结构 */
 struct IpcContextDef
 {
@@ -104,16 +150,23 @@ struct IpcContextDef
     TState*      State;                           /* IPC对象操作的返回值                        */
     TError*      Error;                           /* IPC对象操作的错误代码                      */
     void*        Owner;                           /* IPC对象所属线程                            */
+    TIpcWakeup   Wakeup;                          /* 线程被解除阻塞时的回调函数                 */
+    TIpcReorder  Reorder;                         /* 线程优先级被修改时的回调函数               */
+#if (TCLC_IPC_QUEUE_O1_ENABLE)
+    TPriority    Priority;                        /* 线程进入阻塞队列时的优先级                 */
+#endif
     TLinkNode    LinkNode;                        /* 线程所在IPC队列的链表节点                  */
 };
 typedef struct IpcContextDef TIpcContext;
 
 
+extern void uIpcInitQueue(TIpcQueue* pQueue, TProperty* pProperty);
 extern void uIpcInitContext(TIpcContext* pContext, void* pIpc, TBase32 data, TBase32 len, TOption option,
                             TState* pState, TError* pError);
 extern void uIpcCleanContext(TIpcContext* pContext);
 extern void uIpcBlockThread(TIpcContext* pContext, TIpcQueue* pQueue, TTimeTick ticks);
 extern void uIpcUnblockThread(TIpcContext* pContext,  TState state, TError error, TBool* pHiRP);
+extern void uIpcMoveThread(TIpcContext* pContext, TIpcQueue* pQueue, void* pIpc, TOption option);
 extern void uIpcUnblockAll(TIpcQueue* pQueue, TState state, TError error,
                            void** pData2, TBool* pHiRP);
 extern void uIpcSetPriority(TIpcContext* pContext, TPriority priority);
@@ -49,6 +49,30 @@ extern TState xMailBoxFlush(TMailBox* pMailbox, TError* pError);
 extern TState xMailboxReset(TMailBox* pMailbox, TError* pError);
 extern TState xMailBoxBroadcast(TMailBox* pMailbox, TMail* pMail2, TError* pError);
 
+#if (TCLC_IPC_MMBOX_ENABLE)
+/* 多槽邮箱结构定义，邮件槽位组成环形缓冲区 */
+struct MultiMailBoxDef
+{
+    TProperty      Property;         /* 线程的调度策略等属性配置 */
+    TMail*         Slots;            /* 邮件槽位数组             */
+    TBase32        Depth;            /* 邮件槽位数目             */
+    TBase32        Count;            /* 邮箱中的邮件数目         */
+    TBase32        Head;             /* 最早邮件所在的槽位       */
+    TBase32        Tail;             /* 下一个可写入的槽位       */
+    TIpcQueue      Queue;            /* 邮箱的线程阻塞队列       */
+    TObject        Object;
+};
+typedef struct MultiMailBoxDef TMultiMailBox;
+
+extern TState xMultiMailBoxCreate(TMultiMailBox* pMailbox, TChar* pName, TMail* pSlots, TBase32 depth,
+                                  TProperty property, TError* pError);
+extern TState xMultiMailBoxDelete(TMultiMailBox* pMailbox, TError* pError);
+extern TState xMultiMailBoxSend(TMultiMailBox* pMailbox, TMail* pMail2, TOption option, TTimeTick timeo,
+                                TError* pError);
+extern TState xMultiMailBoxReceive(TMultiMailBox* pMailbox, TMail* pMail2, TOption option, TTimeTick timeo,
+                                   TError* pError);
+#endif
+
 #endif
 
 #endif /* _TOCHILI_MAILBOX_H */
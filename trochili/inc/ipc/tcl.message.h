@@ -11,6 +11,7 @@
 #include "tcl.object.h"
 #include "tcl.ipc.h"
 #include "tcl.thread.h"
+#include "tcl.mem.pool.h"
 
 #if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_MQUE_ENABLE))
 
@@ -45,6 +46,12 @@ struct MessageQueueCB
     TIndex    Tail;          /* 消息队列读指针位置     */
     TMQStatus Status;        /* 消息队列状态           */
     TIpcQueue Queue;         /* 消息队列的线程阻塞队列 */
+#if ((TCLC_IPC_MQUE_LOAN_ENABLE)&&(TCLC_MEMORY_ENABLE)&&(TCLC_MEMORY_POOL_ENABLE))
+    TMemPool* BufferPool;    /* 借出消息缓冲区的内存池 */
+    TProperty LoanProperty;  /* 缓冲区等待队列属性     */
+    TIpcQueue LoanQueue;     /* 等待缓冲区的线程队列   */
+    TBase32   LoanTags[MEM_PAGE_TAGS]; /* 内存页是否已被借出   */
+#endif
     TObject   Object;		
 };
 typedef struct MessageQueueCB TMsgQueue;
@@ -58,10 +65,23 @@ extern TState xMQReceive(TMsgQueue* pMsgQue, TMessage* pMsg2,
 extern TState xMQSend(TMsgQueue* pMsgQue, TMessage* pMsg2,
                              TOption option, TTimeTick timeo, TError* pError);
 extern TState xMQBroadcast(TMsgQueue* pMsgQue, TMessage* pMsg2, TError* pError);
+extern TState xMQReceiveBatch(TMsgQueue* pMsgQue, TMessage* pMsgs, TBase32 number, TBase32* pCount,
+                              TOption option, TTimeTick timeo, TError* pError);
+extern TState xMQSendBatch(TMsgQueue* pMsgQue, TMessage* pMsgs, TBase32 number, TBase32* pCount,
+                           TOption option, TTimeTick timeo, TError* pError);
 extern TState xMQDelete(TMsgQueue* pMsgQue, TError* pError);
 extern TState xMQReset(TMsgQueue* pMsgQue, TError* pError);
 extern TState xMQFlush(TMsgQueue* pMsgQue, TError* pError);
 
+#if ((TCLC_IPC_MQUE_LOAN_ENABLE)&&(TCLC_MEMORY_ENABLE)&&(TCLC_MEMORY_POOL_ENABLE))
+extern TState xMQBindPool(TMsgQueue* pMsgQue, TMemPool* pPool, TError* pError);
+extern TState xMQLoanBuffer(TMsgQueue* pMsgQue, void** pBuf2, TOption option, TTimeTick timeo,
+                            TError* pError);
+extern TState xMQCommitBuffer(TMsgQueue* pMsgQue, void* pBuf, TOption option, TTimeTick timeo,
+                              TError* pError);
+extern TState xMQReturnBuffer(TMsgQueue* pMsgQue, void* pBuf, TError* pError);
+#endif
+
 #endif
 
 #endif /* _TCL_MQUEUE_H */
@@ -32,6 +32,11 @@ extern TState xMutexFree(TMutex* pMutex, TError* pError);
 extern TState xMutexReset(TMutex* pMutex, TError* pError);
 extern TState xMutexFlush(TMutex* pMutex, TError* pError);
 
+#if (TCLC_IPC_CONDVAR_ENABLE)
+extern TState uMutexRelease(TMutex* pMutex, TBase32* pNest, TBool* pHiRP, TError* pError);
+extern TState uMutexGrant(TMutex* pMutex, TThread* pThread, TBool* pHiRP, TError* pError);
+#endif
+
 #endif
 
 #endif /*_TCL_MUTEX_H*/
@@ -0,0 +1,54 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#ifndef _TCL_PRIOQUEUE_H
+#define _TCL_PRIOQUEUE_H
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.object.h"
+#include "tcl.ipc.h"
+#include "tcl.thread.h"
+#include "tcl.message.h"
+
+#if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_MQUE_ENABLE)&&(TCLC_IPC_PMQUE_ENABLE))
+
+/* 优先级消息节点结构定义，由用户提供节点数组作为消息缓冲池 */
+struct PrioMsgNodeDef
+{
+    TMessage                Message;    /* 消息内容                     */
+    struct PrioMsgNodeDef*  Next;       /* 同一优先级队列中的下一个节点 */
+};
+typedef struct PrioMsgNodeDef TPrioMsgNode;
+
+/*
+ * 多优先级消息队列结构定义，每个优先级一个先进先出的节点链表，所有优先级共用一个空闲节点链表，
+ * 用优先级掩码找出最高的非空优先级，使得发送和接收都是O(1)
+ */
+struct PrioMsgQueueDef
+{
+    TProperty     Property;                                 /* 消息队列属性配置           */
+    TPrioMsgNode* FreeList;                                 /* 空闲消息节点链表           */
+    TPrioMsgNode* Heads[TCLC_IPC_PMQUE_PRIORITY_NUM];       /* 各优先级消息链表的读位置   */
+    TPrioMsgNode* Tails[TCLC_IPC_PMQUE_PRIORITY_NUM];       /* 各优先级消息链表的写位置   */
+    TBitMask      PrioMask;                                 /* 非空优先级掩码             */
+    TBase32       Capacity;                                 /* 消息队列容量               */
+    TBase32       MsgEntries;                               /* 消息队列中消息的数目       */
+    TIpcQueue     Queue;                                    /* 消息队列的线程阻塞队列     */
+    TObject       Object;
+};
+typedef struct PrioMsgQueueDef TPrioMsgQueue;
+
+extern TState xPMQCreate(TPrioMsgQueue* pMsgQue, TChar* pName, TPrioMsgNode* pNodes, TBase32 capacity,
+                         TProperty property, TError* pError);
+extern TState xPMQDelete(TPrioMsgQueue* pMsgQue, TError* pError);
+extern TState xPMQSend(TPrioMsgQueue* pMsgQue, TMessage* pMsg2, TPriority priority, TOption option,
+                       TTimeTick timeo, TError* pError);
+extern TState xPMQReceive(TPrioMsgQueue* pMsgQue, TMessage* pMsg2, TOption option, TTimeTick timeo,
+                          TError* pError);
+#endif
+
+#endif /*_TCL_PRIOQUEUE_H*/
+
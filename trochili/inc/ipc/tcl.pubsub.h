@@ -0,0 +1,65 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#ifndef _TCL_PUBSUB_H
+#define _TCL_PUBSUB_H
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.object.h"
+#include "tcl.ipc.h"
+#include "tcl.thread.h"
+#include "tcl.mem.pool.h"
+
+#if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_PUBSUB_ENABLE)&&(TCLC_MEMORY_ENABLE)&&(TCLC_MEMORY_POOL_ENABLE))
+
+/* 主题数据缓冲区头部定义，缓冲区是内存池中的一个内存页，数据紧跟在头部之后 */
+struct TopicBufferDef
+{
+    TBase32 Refs;                      /* 缓冲区的引用计数                   */
+    TBase32 Length;                    /* 发布的数据长度                     */
+};
+typedef struct TopicBufferDef TTopicBuffer;
+
+/* 订阅者结构定义，每个订阅者有自己的有界数据队列 */
+struct SubscriberDef
+{
+    TProperty  Property;               /* 订阅者属性和溢出策略               */
+    struct TopicDef* Topic;            /* 订阅的主题                         */
+    void**     Slots;                  /* 数据缓冲区地址槽位数组             */
+    TBase32    Depth;                  /* 槽位数目                           */
+    TBase32    Count;                  /* 队列中的数据数目                   */
+    TBase32    Head;                   /* 最早数据所在的槽位                 */
+    TBase32    Tail;                   /* 下一个可写入的槽位                 */
+    TBase32    Dropped;                /* 因队列溢出丢弃的数据数目           */
+    struct SubscriberDef* Next;        /* 主题订阅者链表                     */
+    TIpcQueue  Queue;                  /* 等待数据的线程阻塞队列             */
+};
+typedef struct SubscriberDef TSubscriber;
+
+/* 主题结构定义 */
+struct TopicDef
+{
+    TProperty    Property;             /* 主题属性                           */
+    TMemPool*    Pool;                 /* 数据缓冲区所在的内存池             */
+    TSubscriber* Subscribers;          /* 订阅者链表                         */
+    TObject      Object;
+};
+typedef struct TopicDef TTopic;
+
+extern TState xTopicCreate(TTopic* pTopic, TChar* pName, TMemPool* pPool, TError* pError);
+extern TState xTopicDelete(TTopic* pTopic, TError* pError);
+extern TState xTopicSubscribe(TTopic* pTopic, TSubscriber* pSub, void** pSlots, TBase32 depth,
+                              TProperty property, TError* pError);
+extern TState xTopicUnsubscribe(TSubscriber* pSub, TError* pError);
+extern TState xTopicLoan(TTopic* pTopic, void** pData2, TError* pError);
+extern TState xTopicPublish(TTopic* pTopic, void* pData, TBase32 length, TError* pError);
+extern TState xTopicReceive(TSubscriber* pSub, void** pData2, TBase32* pLength, TOption option,
+                            TTimeTick timeo, TError* pError);
+extern TState xTopicRelease(TTopic* pTopic, void* pData, TError* pError);
+#endif
+
+#endif /*_TCL_PUBSUB_H*/
+
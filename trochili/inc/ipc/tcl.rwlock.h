@@ -0,0 +1,39 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#ifndef _TCL_RWLOCK_H
+#define _TCL_RWLOCK_H
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.object.h"
+#include "tcl.ipc.h"
+#include "tcl.thread.h"
+
+#if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_RWLOCK_ENABLE))
+
+/*
+ * 读写锁结构定义，基本线程阻塞队列保存等待写锁的线程，辅助线程阻塞队列保存等待读锁的线程。
+ * 只要有线程在等待写锁，新的读操作就不能再获得读锁，避免写线程被持续的读操作饿死
+ */
+struct RwLockDef
+{
+    TProperty Property;         /* 队列中线程的调度策略等属性配置     */
+    TBase32   Readers;          /* 当前持有读锁的访问者数目           */
+    TThread*  Writer;           /* 当前持有写锁的线程                 */
+    TIpcQueue Queue;            /* 读写锁的线程阻塞队列               */
+    TObject   Object;
+};
+typedef struct RwLockDef TRwLock;
+
+extern TState xRwLockCreate(TRwLock* pRwLock, TChar* pName, TProperty property, TError* pError);
+extern TState xRwLockDelete(TRwLock* pRwLock, TError* pError);
+extern TState xRwLockRead(TRwLock* pRwLock, TOption option, TTimeTick timeo, TError* pError);
+extern TState xRwLockWrite(TRwLock* pRwLock, TOption option, TTimeTick timeo, TError* pError);
+extern TState xRwLockUnlock(TRwLock* pRwLock, TError* pError);
+#endif
+
+#endif /*_TCL_RWLOCK_H*/
+
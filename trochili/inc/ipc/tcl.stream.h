@@ -0,0 +1,44 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#ifndef _TCL_STREAM_H
+#define _TCL_STREAM_H
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.object.h"
+#include "tcl.ipc.h"
+#include "tcl.thread.h"
+
+#if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_STREAM_ENABLE))
+
+/*
+ * 单生产者单消费者字节流缓冲区结构定义。写入位置只由生产者修改，读取位置只由消费者修改，
+ * 读写数据本身不需要关中断，只有消费者阻塞和被唤醒时才进入临界区
+ */
+struct StreamBufferDef
+{
+    TProperty         Property;   /* 队列中线程的调度策略等属性配置     */
+    volatile TByte*   Buffer;     /* 字节环形缓冲区地址                 */
+    TBase32           Size;       /* 环形缓冲区长度,可保存Size-1个字节  */
+    TBase32           Trigger;    /* 唤醒读线程需要的最少字节数         */
+    volatile TBase32  Head;       /* 下一个写入位置,只由生产者修改      */
+    volatile TBase32  Tail;       /* 下一个读取位置,只由消费者修改      */
+    TIpcQueue         Queue;      /* 读线程阻塞队列                     */
+    TObject           Object;
+};
+typedef struct StreamBufferDef TStreamBuffer;
+
+extern TState xStreamBufferCreate(TStreamBuffer* pStream, TChar* pName, TByte* pBuffer, TBase32 size,
+                                  TBase32 trigger, TProperty property, TError* pError);
+extern TState xStreamBufferDelete(TStreamBuffer* pStream, TError* pError);
+extern TState xStreamBufferSend(TStreamBuffer* pStream, TByte* pData, TBase32 length, TBase32* pCount,
+                                TError* pError);
+extern TState xStreamBufferReceive(TStreamBuffer* pStream, TByte* pData, TBase32 length,
+                                   TBase32* pCount, TOption option, TTimeTick timeo, TError* pError);
+#endif
+
+#endif /*_TCL_STREAM_H*/
+
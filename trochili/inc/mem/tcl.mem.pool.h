@@ -32,6 +32,7 @@ extern TState xMemPoolCreate(TMemPool* pPool, void* pData, TBase32 pages, TBase3
 extern TState xMemPoolDelete(TMemPool* pPool, TError* pError);
 extern TState xPoolMemMalloc(TMemPool* pPool, void** pAddr2, TError* pError);
 extern TState xPoolMemFree (TMemPool* pPool, void* pAddr, TError* pError);
+extern TBool uPoolMemCheck(TMemPool* pPool, void* pAddr);
 #endif
 
 #endif /* _TCLC_MEMORY_POOL_H  */
@@ -31,6 +31,17 @@
 #define TCLC_THREAD_STACK_BARRIER_VALUE (0x5A5A5A5A)
 #define TCLC_THREAD_STACK_ALARM_RATIO   (90U)         /* n%, 栈使用量阀值百分比         */
 
+/* 最早截止期优先(EDF)调度配置，EDF线程独占一个保留优先级 */
+#define TCLC_THREAD_EDF_ENABLE          (0)           /* 使能EDF调度功能                */
+#define TCLC_THREAD_EDF_PRIORITY        (10U)         /* EDF线程使用的优先级            */
+#define TCLC_THREAD_EDF_THREAD_NUM      (8U)          /* EDF线程的最大数目              */
+
+/* 线程CPU预算配置 */
+#define TCLC_THREAD_BUDGET_ENABLE       (0)           /* 使能线程CPU预算和补充周期      */
+
+/* 线程运行时间统计配置，在线程切换和时钟节拍中断里读取处理器周期计数器 */
+#define TCLC_THREAD_CYCLE_ENABLE        (0)           /* 使能线程运行周期数统计         */
+
 /* 各种IPC功能配置 */
 #define TCLC_IPC_ENABLE                 (1)
 #define TCLC_IPC_SEMAPHORE_ENABLE       (1)
@@ -38,16 +49,43 @@
 #define TCLC_IPC_MAILBOX_ENABLE         (1)
 #define TCLC_IPC_MQUE_ENABLE            (1)
 #define TCLC_IPC_FLAGS_ENABLE           (1)
+#define TCLC_IPC_RWLOCK_ENABLE          (0)           /* 使能读写锁                     */
+#define TCLC_IPC_CONDVAR_ENABLE         (0)           /* 使能条件变量                   */
+#define TCLC_IPC_BARRIER_ENABLE         (0)           /* 使能屏障和倒计数门闩           */
+#define TCLC_IPC_STREAM_ENABLE          (0)           /* 使能单生产者单消费者字节流     */
+#define TCLC_IPC_PMQUE_ENABLE           (0)           /* 使能多优先级消息队列           */
+#define TCLC_IPC_PMQUE_PRIORITY_NUM     (8U)          /* 消息优先级数目                 */
+#define TCLC_IPC_MMBOX_ENABLE           (0)           /* 使能多槽邮箱和覆盖写模式       */
+#define TCLC_IPC_PUBSUB_ENABLE          (0)           /* 使能主题发布订阅，需要内存池   */
+#define TCLC_IPC_MQUE_LOAN_ENABLE       (0)           /* 使能消息缓冲区借用，需要内存池 */
+#define TCLC_IPC_FLAGS64_ENABLE         (0)           /* 使能64位事件标记               */
+#define TCLC_IPC_QUEUE_O1_ENABLE        (0)           /* 使能按优先级分组的阻塞队列索引 */
 
 /* 定时器功能配置 */
 #define TCLC_TIMER_ENABLE               (1)
 #define TCLC_TIMER_WHEEL_SIZE           (32U)
+#define TCLC_TIMER_HRES_ENABLE          (0)           /* 使能基于硬件定时器的高精度定时器 */
+#define TCLC_TIMER_HRES_CLOCK_FREQ      (TCLC_CPU_CLOCK_FREQ) /* 高精度定时器硬件的输入时钟 */
 
 /* 中断管理配置 */
 #define TCLC_IRQ_ENABLE                 (1)           /* 使能中断管理功能               */
 #define TCLC_IRQ_VECTOR_NUM             (8U)          /* 配置中断向量表表项数目         */
 #define TCLC_IRQ_DAEMON_ENABLE          (1)           /* 使能异步中断处理线程           */
 
+/* 协程功能配置，协程调度器使用信号量唤醒宿主线程 */
+#define TCLC_COROUTINE_ENABLE           (0)           /* 使能共享宿主线程的无栈协程     */
+
+/* 运行到完成任务配置，同一级别的任务共用一个宿主线程和线程栈 */
+#define TCLC_TASK_ENABLE                (0)           /* 使能共享线程栈的运行到完成任务 */
+
+/* 工作队列配置，工作项由一组工作线程按照优先级取出执行，延时工作项使用定时器 */
+#define TCLC_WORKQUEUE_ENABLE           (0)           /* 使能工作队列和工作线程池       */
+#define TCLC_WORKQUEUE_WORKER_NUM       (2U)          /* 每个工作队列最多的工作线程数目 */
+#define TCLC_WORKQUEUE_PRIORITY_NUM     (4U)          /* 工作项优先级桶数目             */
+
+/* 内核性能统计配置 */
+#define TCLC_KERNEL_PROFILE_ENABLE      (0)           /* 使能中断和临界区执行时间统计   */
+
 /* 动态内存管理配置 */
 #define TCLC_MEMORY_ENABLE              (1)
 #define TCLC_MEMORY_POOL_ENABLE         (1)
@@ -59,6 +97,7 @@
 #define TCLC_TIMER_DAEMON_PRIORITY      (2U)
 #define TCLC_TIMER_DAEMON_SLICE         (10U)
 #define TCLC_TIMER_DAEMON_STACK_BYTES   (512U)
+#define TCLC_TIMER_DAEMON_BATCH         (16U)         /* 定时器守护线程每批处理的定时器数目 */
 
 /* 内核中断守护线程优先级和时间片 */
 #define TCLC_IRQ_DAEMON_PRIORITY        (1U)
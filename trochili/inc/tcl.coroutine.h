@@ -0,0 +1,90 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#ifndef _TCL_COROUTINE_H
+#define _TCL_COROUTINE_H
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.object.h"
+#include "tcl.semaphore.h"
+
+#if ((TCLC_COROUTINE_ENABLE) && (TCLC_IPC_ENABLE) && (TCLC_IPC_SEMAPHORE_ENABLE))
+
+#define COROUTINE_ERR_NONE           (TError)(0x0)
+#define COROUTINE_ERR_FAULT          (TError)(0x1<<0)    /* 一般性错误                          */
+#define COROUTINE_ERR_UNREADY        (TError)(0x1<<1)    /* 协程或者协程调度器未初始化          */
+#define COROUTINE_ERR_STATUS         (TError)(0x1<<2)    /* 协程状态错误                        */
+
+#define COROUTINE_PROP_NONE          (TProperty)(0x0)
+#define COROUTINE_PROP_READY         (TProperty)(0x1<<0) /* 协程或者协程调度器就绪标记          */
+
+/* 协程每次运行之后的返回结果 */
+enum CoroutineStateDef
+{
+    eCoroutineWaiting = 0,                               /* 协程等待条件满足或者延时到期        */
+    eCoroutineYielded = 1,                               /* 协程主动让出，下一轮继续运行        */
+    eCoroutineExited  = 2,                               /* 协程运行结束                        */
+};
+typedef enum CoroutineStateDef TCoroutineState;
+
+struct CoroutineDef;
+
+/* 协程函数类型定义，协程没有自己的栈，局部变量在两次运行之间不会被保留 */
+typedef TCoroutineState (*TCoroutineEntry)(struct CoroutineDef* pCoroutine, TArgument data);
+
+/* 协程结构定义 */
+struct CoroutineDef
+{
+    TProperty       Property;                            /* 协程属性                            */
+    TBase32         Label;                               /* 协程下次运行时恢复执行的位置        */
+    TTimeTick       WakeTicks;                           /* 协程延时到期的系统节拍数            */
+    TCoroutineEntry Entry;                               /* 协程函数                            */
+    TArgument       Argument;                            /* 协程函数参数                        */
+    TLinkNode       LinkNode;                            /* 协程所在调度器队列的链表节点        */
+};
+typedef struct CoroutineDef TCoroutine;
+
+/* 协程调度器结构定义，一个调度器里的全部协程共同使用一个宿主线程 */
+struct CoSchedulerDef
+{
+    TProperty       Property;                            /* 协程调度器属性                      */
+    TTimeTick       PollTicks;                           /* 等待条件的协程的轮询周期            */
+    TLinkNode*      Handle;                              /* 协程队列                            */
+    TSemaphore      Signal;                              /* 用于唤醒宿主线程的信号量            */
+};
+typedef struct CoSchedulerDef TCoScheduler;
+
+/*
+ * 协程语句宏，协程函数必须以TCLM_CO_BEGIN开始、以TCLM_CO_END结束，
+ * 等待和让出只能出现在协程函数本身中，不能出现在它调用的其它函数里，
+ * 也不能出现在协程函数自己的switch语句中
+ */
+#define TCLM_CO_BEGIN(CO)     switch ((CO)->Label) { case 0U:
+
+#define TCLM_CO_END(CO)       } (CO)->Label = 0U; return eCoroutineExited
+
+#define TCLM_CO_YIELD(CO) \
+    do { (CO)->Label = __LINE__; return eCoroutineYielded; case __LINE__:; } while (0)
+
+#define TCLM_CO_WAIT_UNTIL(CO, COND) \
+    do { (CO)->Label = __LINE__; case __LINE__: \
+         if (!(COND)) { return eCoroutineWaiting; } } while (0)
+
+#define TCLM_CO_DELAY(CO, TICKS) \
+    do { uCoroutineSetDelay((CO), (TICKS)); (CO)->Label = __LINE__; \
+         return eCoroutineWaiting; case __LINE__:; } while (0)
+
+extern void uCoroutineSetDelay(TCoroutine* pCoroutine, TTimeTick ticks);
+extern TState xCoSchedulerCreate(TCoScheduler* pScheduler, TChar* pName, TTimeTick ticks,
+                                 TError* pError);
+extern TState xCoSchedulerWake(TCoScheduler* pScheduler, TError* pError);
+extern void xCoSchedulerRun(TCoScheduler* pScheduler);
+extern TState xCoroutineSpawn(TCoScheduler* pScheduler, TCoroutine* pCoroutine,
+                              TCoroutineEntry pEntry, TArgument data, TError* pError);
+
+#endif
+
+#endif /* _TCL_COROUTINE_H */
@@ -46,6 +46,30 @@ typedef enum
 #define KERNEL_DIAG_TIMER_ERROR     (0x1<<2U)         /* 定时器错误                            */
 #define KERNEL_DIAG_IRQ_ERROR       (0x1<<3U)         /* 在中断里操作了互斥量                  */
 
+#if (TCLC_KERNEL_PROFILE_ENABLE)
+/* 中断执行时间统计项编号，外部中断直接使用物理中断号 */
+#define KERNEL_PROFILE_TICK_ISR     (TCLC_CPU_IRQ_NUM)                /* 时钟节拍中断          */
+#define KERNEL_PROFILE_ISR_NUM      (TCLC_CPU_IRQ_NUM + 1U)           /* 统计项数目            */
+
+/* 中断执行时间统计结构定义，时间以处理器周期为单位 */
+typedef struct
+{
+    TBase32          Times;                           /* 中断服务程序执行次数                  */
+    TBase32          MinCycles;                       /* 最短执行时间                          */
+    TBase32          MaxCycles;                       /* 最长执行时间                          */
+    TBase32          AvgCycles;                       /* 平均执行时间                          */
+    TTimeTick        TotalCycles;                     /* 累计执行时间                          */
+} TIsrProfile;
+
+/* 临界区关中断时间统计结构定义，时间以处理器周期为单位 */
+typedef struct
+{
+    TBase32          Times;                           /* 进入最外层临界区的次数                */
+    TBase32          MaxCycles;                       /* 最长关中断时间                        */
+    TAddr32          MaxCaller;                       /* 最长临界区的调用者地址                */
+} TCriticalProfile;
+#endif
+
 /* 内核变量结构定义，记录了内核运行时的各种数据 */
 struct KernelVariableDef
 {
@@ -105,6 +129,14 @@ extern void xKernelSetIdleEntry(TSysIdleEntry pEntry);
 extern void xKernelSetFaultEntry(TSysFaultEntry pEntry);
 extern void xKernelGetCurrentThread(TThread** pThread2);
 extern void xKernelGetJiffies(TTimeTick* pJiffies);
+extern TTimeStamp uKernelGetTimeStamp(void);
+extern void xKernelGetTimeStamp(TTimeStamp* pStamp);
+#if (TCLC_KERNEL_PROFILE_ENABLE)
+extern void uKernelRecordIsr(TIndex index, TBase32 cycles);
+extern TState xKernelGetIsrProfile(TIndex index, TIsrProfile* pProfile);
+extern void xKernelGetCriticalProfile(TCriticalProfile* pProfile);
+extern void xKernelResetProfile(void);
+#endif
 extern void xKernelStart(TUserEntry       pUserEntry,
                          TCpuSetupEntry   pCpuEntry,
                          TBoardSetupEntry pBoardEntry,
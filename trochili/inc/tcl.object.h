@@ -17,7 +17,16 @@ enum ObjectTypeDef
     eMutex,
     eMailbox,
     eMessage,
-    eFlag
+    eFlag,
+    eRwLock,
+    eCondVar,
+    eBarrier,
+    eLatch,
+    eStreamBuffer,
+    ePrioMessage,
+    eMultiMailbox,
+    eTopic,
+    eFlag64
 };
 typedef enum ObjectTypeDef TObjectType;
 
@@ -0,0 +1,61 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#ifndef _TCL_TASK_H
+#define _TCL_TASK_H
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.object.h"
+#include "tcl.thread.h"
+
+#if (TCLC_TASK_ENABLE)
+
+#define TASK_ERR_NONE                (TError)(0x0)
+#define TASK_ERR_FAULT               (TError)(0x1<<0)    /* 一般性错误                          */
+#define TASK_ERR_UNREADY             (TError)(0x1<<1)    /* 任务或者任务级别未初始化            */
+#define TASK_ERR_LIMIT               (TError)(0x1<<2)    /* 任务挂起的激活次数达到上限          */
+
+#define TASK_PROP_NONE               (TProperty)(0x0)
+#define TASK_PROP_READY              (TProperty)(0x1<<0) /* 任务或者任务级别就绪标记            */
+
+/*
+ * 任务函数类型定义，任务每次被激活运行一次任务函数，任务函数必须返回，
+ * 不能阻塞、延时或者让出处理器
+ */
+typedef void (*TTaskEntry)(TArgument data);
+
+/* 任务级别结构定义，同一级别的全部任务共同使用一个宿主线程和线程栈，彼此之间不会抢占 */
+struct TaskLevelDef
+{
+    TProperty       Property;                            /* 任务级别属性                        */
+    TLinkNode*      Handle;                              /* 已经被激活的任务队列                */
+    TThread         Thread;                              /* 任务级别的宿主线程                  */
+};
+typedef struct TaskLevelDef TTaskLevel;
+
+/* 运行到完成任务结构定义 */
+struct TaskDef
+{
+    TProperty       Property;                            /* 任务属性                            */
+    TPriority       Priority;                            /* 任务在级别内的优先级                */
+    TBase32         Activations;                         /* 任务挂起的激活次数                  */
+    TBase32         MaxActivations;                      /* 任务允许挂起的最大激活次数          */
+    TTaskEntry      Entry;                               /* 任务函数                            */
+    TArgument       Argument;                            /* 任务函数参数                        */
+    TTaskLevel*     Level;                               /* 任务所属的任务级别                  */
+    TLinkNode       LinkNode;                            /* 任务所在激活队列的链表节点          */
+};
+typedef struct TaskDef TTask;
+
+extern TState xTaskLevelCreate(TTaskLevel* pLevel, TChar* pName, void* pStack, TBase32 bytes,
+                               TPriority priority, TTimeTick ticks, TError* pError);
+extern TState xTaskCreate(TTask* pTask, TTaskLevel* pLevel, TTaskEntry pEntry, TArgument data,
+                          TPriority priority, TBase32 activations, TError* pError);
+extern TState xTaskActivate(TTask* pTask, TError* pError);
+
+#endif
+
+#endif /* _TCL_TASK_H */
@@ -19,6 +19,7 @@
 #define THREAD_DIAG_INVALID_EXIT      (TBitMask)(0x1<<2)  /* 线程非法退出                            */
 #define THREAD_DIAG_INVALID_STATE     (TBitMask)(0x1<<3)  /* 线程操作失败                            */
 #define THREAD_DIAG_INVALID_TIMEO     (TBitMask)(0x1<<4)  /* 线程时限阻塞禁止                        */
+#define THREAD_DIAG_DEADLINE_MISS     (TBitMask)(0x1<<5)  /* EDF线程错过截止期                       */
 
 /* 线程调用错误码定义                 */
 #define THREAD_ERR_NONE               (TError)(0x0)
@@ -38,6 +39,9 @@
 #define THREAD_PROP_CLEAN_STACK       (TProperty)(0x1<<3) /* 主动清空线程栈空间                      */
 #define THREAD_PROP_KERNEL_ROOT       (TProperty)(0x1<<6) /* ROOT线程标记位                          */
 #define THREAD_PROP_KERNEL_DAEMON     (TProperty)(0x1<<4) /* 内核守护线程标记位                      */
+#define THREAD_PROP_EDF               (TProperty)(0x1<<5) /* EDF调度线程标记位                       */
+#define THREAD_PROP_THROTTLED         (TProperty)(0x1<<7) /* 线程CPU预算耗尽标记位                   */
+#define THREAD_PROP_USER_SUSPENDED    (TProperty)(0x1<<8) /* 线程被用户挂起标记位                    */
 
 
 /* 线程权限控制，各种线程API操作时的许可位 */
@@ -54,6 +58,8 @@
 #define THREAD_ACAPI_SLICE            (TBitMask)(0x1<<9)
 #define THREAD_ACAPI_UNBLOCK          (TBitMask)(0x1<<10)
 #define THREAD_ACAPI_BLOCK            (TBitMask)(0x1<<11) /* 和IPC阻塞有关 */
+#define THREAD_ACAPI_DEADLINE         (TBitMask)(0x1<<12)
+#define THREAD_ACAPI_BUDGET           (TBitMask)(0x1<<13)
 #define THREAD_ACAPI_ALL \
     (THREAD_ACAPI_DELETE|\
     THREAD_ACAPI_ACTIVATE|\
@@ -66,8 +72,14 @@
     THREAD_ACAPI_SLICE|\
     THREAD_ACAPI_UNBLOCK|\
     THREAD_ACAPI_BLOCK|\
+    THREAD_ACAPI_DEADLINE|\
+    THREAD_ACAPI_BUDGET|\
     THREAD_ACAPI_YIELD)
 
+/* 线程CPU预算耗尽时的处理方式 */
+#define THREAD_BUDGET_DEMOTE          (TOption)(0x1<<0)   /* 降低到后台优先级直到预算补充            */
+#define THREAD_BUDGET_SUSPEND         (TOption)(0x1<<1)   /* 挂起直到预算补充                        */
+
 /* 线程状态定义  */
 enum ThreadStausdef
 {
@@ -118,9 +130,27 @@ struct ThreadDef
     TBitMask      ACAPI;                     /* 线程可接受的API                                  */
     TPriority     Priority;                  /* 线程当前优先级                                   */
     TPriority     BasePriority;              /* 线程基本优先级                                   */
+    TPriority     Threshold;                 /* 线程抢占阈值，只有更高优先级的线程才能抢占本线程 */
     TTimeTick     Ticks;                     /* 时间片中还剩下的ticks数目                        */
     TTimeTick     BaseTicks;                 /* 时间片长度（ticks数目）                          */
     TTimeTick     Jiffies;                   /* 线程总的运行时钟节拍数                           */
+#if (TCLC_THREAD_CYCLE_ENABLE)
+    TTimeStamp    RunCycles;                 /* 线程总的运行处理器周期数                         */
+#endif
+#if (TCLC_THREAD_EDF_ENABLE)
+    TTimeTick     Deadline;                  /* EDF线程的绝对截止期（系统节拍数）                */
+    TBase32       DeadlineMisses;            /* EDF线程错过截止期的次数                          */
+    TIndex        EdfIndex;                  /* EDF线程在就绪截止期堆中的位置                    */
+#endif
+#if (TCLC_THREAD_BUDGET_ENABLE)
+    TTimeTick     BudgetTicks;               /* 线程在每个补充周期内的CPU预算                    */
+    TTimeTick     BudgetRemain;              /* 线程剩余的CPU预算                                */
+    TTimeTick     BudgetPeriod;              /* 线程CPU预算的补充周期                            */
+    TTimeTick     BudgetStamp;               /* 线程CPU预算的补充时刻                            */
+    TOption       BudgetOption;              /* 线程CPU预算耗尽时的处理方式                      */
+    TPriority     BudgetPriority;            /* 线程CPU预算耗尽时降低到的后台优先级              */
+    TLinkNode     BudgetNode;                /* 线程所在CPU预算队列的节点                        */
+#endif
     TThreadEntry  Entry;                     /* 线程的主函数                                     */
     TArgument     Argument;                  /* 线程主函数的用户参数,用户来赋值                  */
     TBitMask      Diagnosis;                 /* 线程运行错误码                                   */
@@ -137,6 +167,17 @@ struct ThreadDef
 };
 typedef struct ThreadDef TThread;
 
+#if (TCLC_THREAD_CYCLE_ENABLE)
+/* 线程运行时间统计结构定义，负载以千分比为单位                                                  */
+typedef struct
+{
+    TTimeStamp    RunCycles;                 /* 线程总的运行处理器周期数                         */
+    TTimeStamp    TotalCycles;               /* 全部线程总的运行处理器周期数                     */
+    TBase32       Load;                      /* 线程的处理器负载                                 */
+    TBase32       IdleLoad;                  /* ROOT线程也就是系统空闲时间所占的比例             */
+} TThreadStats;
+#endif
+
 #define NODE2THREAD(NODE) ((TThread*)((TByte*)(NODE) - OFF_SET_OF(TThread, LinkNode)))
 
 
@@ -151,6 +192,7 @@ extern void uThreadTimerUpdate(void);
 extern void uThreadModuleInit(void);
 extern void uThreadResumeFromISR(TThread* pThread);
 extern void uThreadSuspendSelf(void);
+extern TBool uThreadCheckPreempt(TThread* pThread);
 extern void uThreadCreate(TThread*    pThread,
                           TChar*        pName,
                           TThreadStatus status,
@@ -161,10 +203,12 @@ extern void uThreadCreate(TThread*    pThread,
                           void*         pStack,
                           TBase32       bytes,
                           TPriority     priority,
+                          TPriority     threshold,
                           TTimeTick     ticks);
 extern TState uThreadDelete(TThread* pThread, TError* pError);
 extern TState uThreadSetPriority(TThread* pThread, TPriority priority,
                                  TBool flag, TBool* pHiRP, TError* pError);
+extern TPriority uThreadGetBasePriority(TThread* pThread);
 extern TState xThreadCreate(TThread* pThread,
                             TChar*        pName,
                             TThreadStatus status,
@@ -175,6 +219,7 @@ extern TState xThreadCreate(TThread* pThread,
                             void*         pStack,
                             TBase32       bytes,
                             TPriority     priority,
+                            TPriority     threshold,
                             TTimeTick     ticks,
                             TError*       pError);
 extern TState xThreadDelete(TThread* pThread, TError* pError);
@@ -186,7 +231,18 @@ extern TState xThreadDelay(TTimeTick ticks, TError* pError);
 extern TState xThreadUndelay(TThread* pThread, TError* pError);
 extern TState xThreadYield(TError* pError);
 extern TState xThreadSetPriority(TThread* pThread, TPriority priority, TError* pError);
+extern TState xThreadSetThreshold(TThread* pThread, TPriority threshold, TError* pError);
+#if (TCLC_THREAD_CYCLE_ENABLE)
+extern TState xThreadGetStats(TThread* pThread, TThreadStats* pStats, TError* pError);
+#endif
 extern TState xThreadSetTimeSlice(TThread* pThread, TTimeTick ticks, TError* pError);
+#if (TCLC_THREAD_EDF_ENABLE)
+extern TState xThreadSetDeadline(TThread* pThread, TTimeTick ticks, TError* pError);
+#endif
+#if (TCLC_THREAD_BUDGET_ENABLE)
+extern TState xThreadSetBudget(TThread* pThread, TTimeTick budget, TTimeTick period,
+                               TOption option, TPriority priority, TError* pError);
+#endif
 #if (TCLC_IPC_ENABLE)
 extern TState xThreadUnblock(TThread* pThread, TError* pError);
 #endif
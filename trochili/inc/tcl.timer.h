@@ -31,8 +31,16 @@ typedef enum TimerStatusDef TTimerStatus;
 #define TIMER_PROP_EXPIRED        (0x1<<1)              /* 定时器期满标记                       */
 #define TIMER_PROP_PERIODIC       (0x1<<2)              /* 用户周期回调定时器                   */
 #define TIMER_PROP_ACCURATE       (0x1<<3)              /* 用户精准定时器                       */
+#define TIMER_PROP_ISR            (0x1<<4)              /* 回调函数在时钟节拍中断中执行         */
 
-#define TIMER_USER_PROPERTY    (TIMER_PROP_PERIODIC| TIMER_PROP_ACCURATE)
+#define TIMER_USER_PROPERTY    (TIMER_PROP_PERIODIC| TIMER_PROP_ACCURATE| TIMER_PROP_ISR)
+
+/*
+ * 具有TIMER_PROP_ISR属性的定时器，其回调函数在时钟节拍中断中、关中断的状态下直接执行，
+ * 省去了唤醒定时器守护线程的两次线程切换。回调函数必须短小，并且只能调用不会引起线程阻塞的
+ * ISR接口，例如TclIsrReleaseSemaphore、TclIsrSendMail、TclIsrSendMessage、TclSendFlags、
+ * TclStartTimer和TclStopTimer等。
+ */
 
 /* 定时器运行错误码定义 */
 #define TIMER_DIAG_NORMAL         (TBitMask)(0x0)       /* 定时器正常                            */
@@ -48,6 +56,8 @@ struct TimerDef
     TTimerStatus  Status;                                /* 定时器状态                           */
     TTimeTick     MatchTicks;                            /* 定时器到时时刻                       */
     TTimeTick     PeriodTicks;                           /* 定时器延时计数                       */
+    TTimeTick     SlackTicks;                            /* 定时器允许的到时延缓节拍数           */
+    TTimeTick     DueTicks;                              /* 定时器不考虑延缓时的到时时刻         */
     TTimerRoutine Routine;                               /* 用户定时器回调函数                   */
     TArgument     Argument;                              /* 定时器延时回调参数                   */
     TPriority     Priority;                              /* 定时器回调优先级                     */
@@ -55,18 +65,56 @@ struct TimerDef
     TLinkNode     ExpiredNode;                           /* 定时器期满队列的链表指针             */
     TBase32       ExpiredTimes;                          /* 定时器期满次数                       */	
     TBitMask      Diagnosis;                             /* 定时器运行错误码                     */
+    TBase32       Generation;                            /* 定时器配置版本号                     */
     TLinkNode     LinkNode;                              /* 定时器所在队列的链表指针             */
     TObject       Object;
 };
 typedef struct TimerDef TTimer;
 
 
+#if (TCLC_TIMER_HRES_ENABLE)
+/* 高精度定时器回调函数类型定义 */
+typedef void(*THrTimerRoutine)(TArgument data);
+
+/*
+ * 高精度单次定时器结构定义。到时时刻以微秒为单位，不受时钟节拍频率限制，
+ * 回调函数在硬件定时器中断中执行，只能调用ISR接口。定时器使用前必须先初始化
+ */
+struct HrTimerDef
+{
+    TProperty       Property;                            /* 高精度定时器属性                     */
+    TTimerStatus    Status;                              /* 高精度定时器状态                     */
+    TTimeStamp      MatchStamp;                          /* 高精度定时器到时时刻                 */
+    THrTimerRoutine Routine;                             /* 高精度定时器回调函数                 */
+    TArgument       Argument;                            /* 高精度定时器回调参数                 */
+    TLinkNode       LinkNode;                            /* 高精度定时器所在队列的链表指针       */
+};
+typedef struct HrTimerDef THrTimer;
+#endif
+
+
+/* 定时器守护线程批处理统计结构定义 */
+struct TimerBatchStatsDef
+{
+    TBase32       Batches;                               /* 已处理的批次数                       */
+    TBase32       Timers;                                /* 已处理的定时器总数                   */
+    TBase32       MaxBatchSize;                          /* 单批处理的最大定时器数目             */
+    TBase32       Overruns;                              /* 回调执行跨越了时钟节拍的批次数       */
+    TTimeTick     MaxLagTicks;                           /* 定时器期满到回调之间的最大漂移       */
+};
+typedef struct TimerBatchStatsDef TTimerBatchStats;
+
+
 /* 定时器队列结构定义 */
 struct TimerListDef
 {
     TLinkNode*    DormantHandle;
     TLinkNode*    ActiveHandle[TCLC_TIMER_WHEEL_SIZE];
     TLinkNode*    ExpiredHandle;
+    TLinkNode*    IsrExpiredHandle;
+#if (TCLC_TIMER_HRES_ENABLE)
+    TLinkNode*    HresHandle;
+#endif
 };
 typedef struct TimerListDef TTimerList;
 
@@ -80,7 +128,16 @@ extern TState xTimerCreate(TTimer* pTimer, TChar* pName, TProperty property, TTi
 extern TState xTimerDelete(TTimer * pTimer, TError* pError);
 extern TState xTimerStart(TTimer* pTimer, TTimeTick lagticks, TError* pError);
 extern TState xTimerStop(TTimer* pTimer, TError* pError);
-extern TState xTimerConfig(TTimer* pTimer, TTimeTick ticks, TPriority priority, TError* pError);
+extern TState xTimerConfig(TTimer* pTimer, TTimeTick ticks, TPriority priority, TTimeTick slack,
+                           TError* pError);
+extern void xTimerGetBatchStats(TTimerBatchStats* pStats);
+#if (TCLC_TIMER_HRES_ENABLE)
+extern TState xTimerInitHres(THrTimer* pTimer, THrTimerRoutine pRoutine, TArgument data,
+                             TError* pError);
+extern TState xTimerStartHres(THrTimer* pTimer, TTimeStamp usecs, TError* pError);
+extern TState xTimerStopHres(THrTimer* pTimer, TError* pError);
+extern void xTimerHresISR(void);
+#endif
 extern void uTimerCreateDaemon(void);
 #endif
 
@@ -15,6 +15,7 @@ typedef unsigned int       TReg32;
 typedef unsigned int       TIndex;
 typedef unsigned int       TPriority;
 typedef unsigned int       TBitMask;
+typedef unsigned long long TBitMask64;
 typedef unsigned int       TOption;
 typedef unsigned int       TProperty;
 typedef unsigned long long TTimeTick;
@@ -0,0 +1,79 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#ifndef _TCL_WORKQUEUE_H
+#define _TCL_WORKQUEUE_H
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.object.h"
+#include "tcl.thread.h"
+#include "tcl.timer.h"
+
+#if ((TCLC_WORKQUEUE_ENABLE) && (TCLC_TIMER_ENABLE))
+
+#define WORK_ERR_NONE                (TError)(0x0)
+#define WORK_ERR_FAULT               (TError)(0x1<<0)    /* 一般性错误                          */
+#define WORK_ERR_UNREADY             (TError)(0x1<<1)    /* 工作项或者工作队列未初始化          */
+#define WORK_ERR_STATUS              (TError)(0x1<<2)    /* 工作项状态错误                      */
+
+#define WORK_PROP_NONE               (TProperty)(0x0)
+#define WORK_PROP_READY              (TProperty)(0x1<<0) /* 工作项或者工作队列就绪标记          */
+#define WORK_PROP_RUNNING            (TProperty)(0x1<<1) /* 工作项正在被工作线程执行标记        */
+
+/* 工作项状态枚举定义 */
+enum WorkStatusDef
+{
+    eWorkIdle = 0,                                       /* 工作项空闲                          */
+    eWorkDelayed,                                        /* 工作项等待延时定时器到时            */
+    eWorkPending,                                        /* 工作项在工作队列中等待执行          */
+    eWorkRunning,                                        /* 工作项正在被工作线程执行            */
+};
+
+/*
+ * 工作项执行期间可以被再次提交，这时工作项保持WORK_PROP_RUNNING标记，状态变为eWorkDelayed或者
+ * eWorkPending，但是直到本次执行结束才真正进入工作队列，所以同一个工作项不会被两个工作线程同时执行
+ */
+typedef enum WorkStatusDef TWorkStatus;
+
+/* 工作函数类型定义，工作函数在工作线程中执行，允许阻塞和延时 */
+typedef void (*TWorkEntry)(TArgument data);
+
+/* 工作队列结构定义，工作项按照优先级分桶，同一个桶内的工作项按照提交的先后顺序执行 */
+struct WorkQueueDef
+{
+    TProperty       Property;                            /* 工作队列属性                        */
+    TBase32         WorkerNum;                           /* 工作线程数目                        */
+    TLinkNode*      Handle[TCLC_WORKQUEUE_PRIORITY_NUM]; /* 各优先级的待执行工作项队列          */
+    TThread         Workers[TCLC_WORKQUEUE_WORKER_NUM];  /* 工作线程池                          */
+};
+typedef struct WorkQueueDef TWorkQueue;
+
+/* 工作项结构定义 */
+struct WorkItemDef
+{
+    TProperty       Property;                            /* 工作项属性                          */
+    TWorkStatus     Status;                              /* 工作项状态                          */
+    TPriority       Priority;                            /* 工作项优先级，也就是所在桶的编号    */
+    TWorkEntry      Entry;                               /* 工作函数                            */
+    TArgument       Argument;                            /* 工作函数参数                        */
+    TWorkQueue*     Queue;                               /* 工作项所属的工作队列                */
+    TLinkNode       LinkNode;                            /* 工作项所在队列的链表节点            */
+    TTimer          Timer;                               /* 延时提交工作项使用的定时器          */
+};
+typedef struct WorkItemDef TWorkItem;
+
+extern TState xWorkQueueCreate(TWorkQueue* pQueue, TChar* pName, void* pStack, TBase32 bytes,
+                               TBase32 workers, TPriority priority, TTimeTick ticks,
+                               TError* pError);
+extern TState xWorkItemCreate(TWorkItem* pItem, TChar* pName, TWorkQueue* pQueue,
+                              TWorkEntry pEntry, TArgument data, TPriority priority,
+                              TError* pError);
+extern TState xWorkItemSubmit(TWorkItem* pItem, TTimeTick ticks, TError* pError);
+extern TState xWorkItemCancel(TWorkItem* pItem, TError* pError);
+
+#endif
+
+#endif /* _TCL_WORKQUEUE_H */
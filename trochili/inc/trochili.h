@@ -20,8 +20,17 @@
 #include "tcl.mailbox.h"
 #include "tcl.message.h"
 #include "tcl.flags.h"
+#include "tcl.rwlock.h"
+#include "tcl.condvar.h"
+#include "tcl.barrier.h"
+#include "tcl.stream.h"
+#include "tcl.prioqueue.h"
 #include "tcl.mem.pool.h"
+#include "tcl.pubsub.h"
 #include "tcl.mem.buddy.h"
+#include "tcl.coroutine.h"
+#include "tcl.task.h"
+#include "tcl.workqueue.h"
 
 
 #define TCLM_ASSERT KNL_ASSERT
@@ -46,6 +55,12 @@ extern TState TclUnlockScheduler(void);
 extern TState TclLockScheduler(void);
 extern void TclTrace(const char* pNote);
 
+#if (TCLC_KERNEL_PROFILE_ENABLE)
+extern TState TclGetIsrProfile(TIndex index, TIsrProfile* pProfile);
+extern void TclGetCriticalProfile(TCriticalProfile* pProfile);
+extern void TclResetProfile(void);
+#endif
+
 /* 线程操作结果，用户程序使用 */
 #define TCLE_THREAD_NONE             (THREAD_ERR_NONE)
 #define TCLE_THREAD_UNREADY          (THREAD_ERR_UNREADY)
@@ -54,6 +69,10 @@ extern void TclTrace(const char* pNote);
 #define TCLE_THREAD_STATUS           (THREAD_ERR_STATUS)
 #define TCLE_THREAD_PRIORITY         (THREAD_ERR_PRIORITY)
 
+/* 线程CPU预算耗尽时的处理方式，用户程序使用 */
+#define TCLO_THREAD_BUDGET_DEMOTE    (THREAD_BUDGET_DEMOTE)
+#define TCLO_THREAD_BUDGET_SUSPEND   (THREAD_BUDGET_SUSPEND)
+
 extern TState TclCreateThread(TThread* pThread,
                             TChar* pName,
                             TThreadEntry pEntry,
@@ -70,6 +89,17 @@ extern TState TclSuspendThread(TThread* pThread, TError* pError);
 extern TState TclResumeThread(TThread* pThread, TError* pError);
 extern TState TclSetThreadPriority(TThread* pThread, TPriority priority, TError* pError);
 extern TState TclSetThreadSlice(TThread* pThread, TTimeTick ticks, TError* pError);
+extern TState TclSetThreadThreshold(TThread* pThread, TPriority threshold, TError* pError);
+#if (TCLC_THREAD_CYCLE_ENABLE)
+extern TState TclGetThreadStats(TThread* pThread, TThreadStats* pStats, TError* pError);
+#endif
+#if (TCLC_THREAD_EDF_ENABLE)
+extern TState TclSetThreadDeadline(TThread* pThread, TTimeTick ticks, TError* pError);
+#endif
+#if (TCLC_THREAD_BUDGET_ENABLE)
+extern TState TclSetThreadBudget(TThread* pThread, TTimeTick budget, TTimeTick period,
+                                 TOption option, TPriority priority, TError* pError);
+#endif
 extern TState TclYieldThread(TError* pError);
 extern TState TclDelayThread(TTimeTick ticks, TError* pError);
 extern TState TclUnDelayThread(TThread* pThread, TError* pError);
@@ -83,6 +113,7 @@ extern TState TclUnblockThread(TThread* pThread, TError* pError);
 #define TCLP_TIMER_DEFAULT         (TIMER_PROP_DEAULT)
 #define TCLP_TIMER_PERIODIC        (TIMER_PROP_PERIODIC)
 #define TCLP_TIMER_ACCURATE        (TIMER_PROP_ACCURATE)
+#define TCLP_TIMER_ISR             (TIMER_PROP_ISR)
 
 /* 用户定时器操作结果，用户程序使用 */
 #define TCLE_TIMER_NONE            (TIMER_ERR_NONE)
@@ -95,7 +126,15 @@ extern TState TclCreateTimer(TTimer* pTimer, TChar* pName, TProperty property, T
 extern TState TclDeleteTimer(TTimer* pTimer, TError* pError);
 extern TState TclStartTimer(TTimer* pTimer, TTimeTick lagticks, TError* pError);
 extern TState TclStopTimer(TTimer* pTimer, TError* pError);
-extern TState TclConfigTimer(TTimer* pTimer, TTimeTick ticks, TPriority priority, TError* pError);
+extern TState TclConfigTimer(TTimer* pTimer, TTimeTick ticks, TPriority priority, TTimeTick slack,
+                             TError* pError);
+extern void TclGetTimerBatchStats(TTimerBatchStats* pStats);
+#if (TCLC_TIMER_HRES_ENABLE)
+extern TState TclInitHrTimer(THrTimer* pTimer, THrTimerRoutine pRoutine, TArgument data,
+                             TError* pError);
+extern TState TclStartHrTimer(THrTimer* pTimer, TTimeStamp usecs, TError* pError);
+extern TState TclStopHrTimer(THrTimer* pTimer, TError* pError);
+#endif
 
 #endif
 
@@ -139,6 +178,7 @@ extern TState TclCancelIRQ(TIrq* pIRQ, TError* pError);
 #define TCLP_IPC_PREEMP_AUXIQ    (IPC_PROP_PREEMP_AUXIQ)
 #define TCLP_IPC_PREEMP_PRIMIQ   (IPC_PROP_PREEMP_PRIMIQ)
 #define TCLP_IPC_PREEMPTIVE      (IPC_PROP_PREEMP_PRIMIQ|IPC_PROP_PREEMP_AUXIQ)
+#define TCLP_IPC_OVERWRITE       (IPC_PROP_OVERWRITE)
 
 /* IPC选项，用户程序使用 */
 #define TCLO_IPC_DEFAULT         (IPC_OPT_DEFAULT)
@@ -184,6 +224,65 @@ extern TState TclResetFlags(TFlags* pFlags, TError* pError);
 extern TState TclFlushFlags(TFlags* pFlags,  TError* pError);
 #endif
 
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_FLAGS_ENABLE) && (TCLC_IPC_FLAGS64_ENABLE))
+extern TState TclCreateFlags64(TFlags64* pFlags, TChar* pName, TProperty property, TError* pError);
+extern TState TclDeleteFlags64(TFlags64* pFlags, TError* pError);
+extern TState TclSendFlags64(TFlags64* pFlags, TBitMask64 pattern, TError* pError);
+extern TState TclReceiveFlags64(TFlags64* pFlags, TBitMask64* pPattern, TOption option,
+                                TTimeTick timeo, TError* pError);
+extern TState TclResetFlags64(TFlags64* pFlags, TError* pError);
+extern TState TclFlushFlags64(TFlags64* pFlags, TError* pError);
+#endif
+
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_RWLOCK_ENABLE))
+extern TState TclCreateRwLock(TRwLock* pRwLock, TChar* pName, TProperty property, TError* pError);
+extern TState TclDeleteRwLock(TRwLock* pRwLock, TError* pError);
+extern TState TclReadLock(TRwLock* pRwLock, TOption option, TTimeTick timeo, TError* pError);
+extern TState TclWriteLock(TRwLock* pRwLock, TOption option, TTimeTick timeo, TError* pError);
+extern TState TclUnlockRwLock(TRwLock* pRwLock, TError* pError);
+#endif
+
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_MUTEX_ENABLE) && (TCLC_IPC_CONDVAR_ENABLE))
+extern TState TclCreateCondVar(TCondVar* pCondVar, TChar* pName, TMutex* pMutex, TProperty property,
+                               TError* pError);
+extern TState TclDeleteCondVar(TCondVar* pCondVar, TError* pError);
+extern TState TclWaitCondVar(TCondVar* pCondVar, TOption option, TTimeTick timeo, TError* pError);
+extern TState TclSignalCondVar(TCondVar* pCondVar, TError* pError);
+extern TState TclBroadcastCondVar(TCondVar* pCondVar, TError* pError);
+#endif
+
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_BARRIER_ENABLE))
+extern TState TclCreateBarrier(TBarrier* pBarrier, TChar* pName, TBase32 parties, TProperty property,
+                               TError* pError);
+extern TState TclDeleteBarrier(TBarrier* pBarrier, TError* pError);
+extern TState TclWaitBarrier(TBarrier* pBarrier, TOption option, TTimeTick timeo, TError* pError);
+extern TState TclCreateLatch(TLatch* pLatch, TChar* pName, TBase32 count, TProperty property,
+                             TError* pError);
+extern TState TclDeleteLatch(TLatch* pLatch, TError* pError);
+extern TState TclCountDownLatch(TLatch* pLatch, TError* pError);
+extern TState TclWaitLatch(TLatch* pLatch, TOption option, TTimeTick timeo, TError* pError);
+#endif
+
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_STREAM_ENABLE))
+extern TState TclCreateStreamBuffer(TStreamBuffer* pStream, TChar* pName, TByte* pBuffer, TBase32 size,
+                                    TBase32 trigger, TProperty property, TError* pError);
+extern TState TclDeleteStreamBuffer(TStreamBuffer* pStream, TError* pError);
+extern TState TclSendStream(TStreamBuffer* pStream, TByte* pData, TBase32 length, TBase32* pCount,
+                            TError* pError);
+extern TState TclReceiveStream(TStreamBuffer* pStream, TByte* pData, TBase32 length, TBase32* pCount,
+                               TOption option, TTimeTick timeo, TError* pError);
+#endif
+
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_MQUE_ENABLE) && (TCLC_IPC_PMQUE_ENABLE))
+extern TState TclCreatePrioMsgQueue(TPrioMsgQueue* pMsgQue, TChar* pName, TPrioMsgNode* pNodes,
+                                    TBase32 capacity, TProperty property, TError* pError);
+extern TState TclDeletePrioMsgQueue(TPrioMsgQueue* pMsgQue, TError* pError);
+extern TState TclSendPrioMessage(TPrioMsgQueue* pMsgQue, TMessage* pMsg2, TPriority priority,
+                                 TOption option, TTimeTick timeo, TError* pError);
+extern TState TclReceivePrioMessage(TPrioMsgQueue* pMsgQue, TMessage* pMsg2, TOption option,
+                                    TTimeTick timeo, TError* pError);
+#endif
+
 #if ((TCLC_IPC_ENABLE) && (TCLC_IPC_MAILBOX_ENABLE))
 extern TState TclCreateMailBox(TMailBox* pMailbox, TChar* pName, TProperty property, TError* pError);
 extern TState TclDeleteMailBox(TMailBox* pMailbox, TError* pError);
@@ -197,6 +296,16 @@ extern TState TclResetMailBox(TMailBox* pMailbox, TError* pError);
 extern TState TclFlushMailBox(TMailBox* pMailbox, TError* pError);
 #endif
 
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_MAILBOX_ENABLE) && (TCLC_IPC_MMBOX_ENABLE))
+extern TState TclCreateMultiMailBox(TMultiMailBox* pMailbox, TChar* pName, TMail* pSlots, TBase32 depth,
+                                    TProperty property, TError* pError);
+extern TState TclDeleteMultiMailBox(TMultiMailBox* pMailbox, TError* pError);
+extern TState TclReceiveMultiMail(TMultiMailBox* pMailbox, TMail* pMail2, TOption option,
+                                  TTimeTick timeo, TError* pError);
+extern TState TclSendMultiMail(TMultiMailBox* pMailbox, TMail* pMail2, TOption option,
+                               TTimeTick timeo, TError* pError);
+#endif
+
 #if ((TCLC_IPC_ENABLE) && (TCLC_IPC_MQUE_ENABLE))
 extern TState TclCreateMsgQueue(TMsgQueue* pMsgQue, TChar* pName, void** pPool2, TBase32 capacity,
                               TProperty property, TError* pError);
@@ -205,12 +314,71 @@ extern TState TclReceiveMessage(TMsgQueue* pMsgQue, TMessage* pMsg2, TOption opt
                                 TTimeTick timeo, TError* pError);
 extern TState TclSendMessage(TMsgQueue* pMsgQue, TMessage* pMsg2, TOption option,
                              TTimeTick timeo, TError* pError);
+extern TState TclReceiveMessages(TMsgQueue* pMsgQue, TMessage* pMsgs, TBase32 number, TBase32* pCount,
+                                 TOption option, TTimeTick timeo, TError* pError);
+extern TState TclSendMessages(TMsgQueue* pMsgQue, TMessage* pMsgs, TBase32 number, TBase32* pCount,
+                              TOption option, TTimeTick timeo, TError* pError);
 extern TState TclIsrSendMessage(TMsgQueue* pMsgQue, TMessage* pMsg2, TOption option, TError* pError);
 extern TState TclBroadcastMessage(TMsgQueue* pMsgQue, TMessage* pMsg2, TError* pError);
 extern TState TclFlushMsgQueue(TMsgQueue* pMsgQue, TError* pError);
 extern TState TclResetMsgQueue(TMsgQueue* pMsgQue, TError* pError);
 #endif
 
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_MQUE_ENABLE) && (TCLC_IPC_MQUE_LOAN_ENABLE) && (TCLC_MEMORY_ENABLE) && (TCLC_MEMORY_POOL_ENABLE))
+extern TState TclBindMsgQueuePool(TMsgQueue* pMsgQue, TMemPool* pPool, TError* pError);
+extern TState TclLoanMsgBuffer(TMsgQueue* pMsgQue, void** pBuf2, TOption option, TTimeTick timeo,
+                               TError* pError);
+extern TState TclCommitMsgBuffer(TMsgQueue* pMsgQue, void* pBuf, TOption option, TTimeTick timeo,
+                                 TError* pError);
+extern TState TclReturnMsgBuffer(TMsgQueue* pMsgQue, void* pBuf, TError* pError);
+#endif
+
+#if ((TCLC_COROUTINE_ENABLE) && (TCLC_IPC_ENABLE) && (TCLC_IPC_SEMAPHORE_ENABLE))
+/* 协程操作结果，用户程序使用 */
+#define TCLE_COROUTINE_NONE         (COROUTINE_ERR_NONE)
+#define TCLE_COROUTINE_FAULT        (COROUTINE_ERR_FAULT)
+#define TCLE_COROUTINE_UNREADY      (COROUTINE_ERR_UNREADY)
+#define TCLE_COROUTINE_STATUS       (COROUTINE_ERR_STATUS)
+
+extern TState TclCreateCoScheduler(TCoScheduler* pScheduler, TChar* pName, TTimeTick ticks,
+                                   TError* pError);
+extern TState TclWakeCoScheduler(TCoScheduler* pScheduler, TError* pError);
+extern void TclRunCoScheduler(TCoScheduler* pScheduler);
+extern TState TclSpawnCoroutine(TCoScheduler* pScheduler, TCoroutine* pCoroutine,
+                                TCoroutineEntry pEntry, TArgument data, TError* pError);
+#endif
+
+#if (TCLC_TASK_ENABLE)
+/* 运行到完成任务操作结果，用户程序使用 */
+#define TCLE_TASK_NONE              (TASK_ERR_NONE)
+#define TCLE_TASK_FAULT             (TASK_ERR_FAULT)
+#define TCLE_TASK_UNREADY           (TASK_ERR_UNREADY)
+#define TCLE_TASK_LIMIT             (TASK_ERR_LIMIT)
+
+extern TState TclCreateTaskLevel(TTaskLevel* pLevel, TChar* pName, void* pStack, TBase32 bytes,
+                                 TPriority priority, TTimeTick ticks, TError* pError);
+extern TState TclCreateTask(TTask* pTask, TTaskLevel* pLevel, TTaskEntry pEntry, TArgument data,
+                            TPriority priority, TBase32 activations, TError* pError);
+extern TState TclActivateTask(TTask* pTask, TError* pError);
+#endif
+
+#if ((TCLC_WORKQUEUE_ENABLE) && (TCLC_TIMER_ENABLE))
+/* 工作队列操作结果，用户程序使用 */
+#define TCLE_WORK_NONE              (WORK_ERR_NONE)
+#define TCLE_WORK_FAULT             (WORK_ERR_FAULT)
+#define TCLE_WORK_UNREADY           (WORK_ERR_UNREADY)
+#define TCLE_WORK_STATUS            (WORK_ERR_STATUS)
+
+extern TState TclCreateWorkQueue(TWorkQueue* pQueue, TChar* pName, void* pStack, TBase32 bytes,
+                                 TBase32 workers, TPriority priority, TTimeTick ticks,
+                                 TError* pError);
+extern TState TclCreateWorkItem(TWorkItem* pItem, TChar* pName, TWorkQueue* pQueue,
+                                TWorkEntry pEntry, TArgument data, TPriority priority,
+                                TError* pError);
+extern TState TclSubmitWorkItem(TWorkItem* pItem, TTimeTick ticks, TError* pError);
+extern TState TclCancelWorkItem(TWorkItem* pItem, TError* pError);
+#endif
+
 #if (TCLC_MEMORY_ENABLE)
 
 /* 内存操作结果，用户程序使用 */
@@ -229,6 +397,19 @@ extern TState TclMallocPoolMemory (TMemPool* pPool, void** pAddr2, TError* pErro
 extern TState TclFreePoolMemory (TMemPool* pPool, void* pAddr, TError* pError);
 #endif
 
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_PUBSUB_ENABLE) && (TCLC_MEMORY_ENABLE) && (TCLC_MEMORY_POOL_ENABLE))
+extern TState TclCreateTopic(TTopic* pTopic, TChar* pName, TMemPool* pPool, TError* pError);
+extern TState TclDeleteTopic(TTopic* pTopic, TError* pError);
+extern TState TclSubscribeTopic(TTopic* pTopic, TSubscriber* pSub, void** pSlots, TBase32 depth,
+                                TProperty property, TError* pError);
+extern TState TclUnsubscribeTopic(TSubscriber* pSub, TError* pError);
+extern TState TclLoanTopicBuffer(TTopic* pTopic, void** pData2, TError* pError);
+extern TState TclPublishTopic(TTopic* pTopic, void* pData, TBase32 length, TError* pError);
+extern TState TclReceiveTopic(TSubscriber* pSub, void** pData2, TBase32* pLength, TOption option,
+                              TTimeTick timeo, TError* pError);
+extern TState TclReleaseTopicBuffer(TTopic* pTopic, void* pData, TError* pError);
+#endif
+
 #if (TCLC_MEMORY_ENABLE && TCLC_MEMORY_BUDDY_ENABLE)
 extern TState TclCreateMemoryBuddy(TMemBuddy* pBuddy, TChar* pAddr, TBase32 pages, TBase32 pagesize, TError* pError);
 extern TState TclDeleteMemoryBuddy(TMemBuddy* pBuddy, TError* pError);
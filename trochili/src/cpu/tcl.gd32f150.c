@@ -7,6 +7,7 @@
 #include "tcl.config.h"
 #include "tcl.cpu.h"
 #include "tcl.kernel.h"
+#include "tcl.timer.h"
 #include "tcl.gd32f150.h"
 
 /* SysTick Ctrl & Status Reg.          */
@@ -35,6 +36,41 @@
 #define CM3_PRIO_PENDSV      (0xE000ED22)
 #define CM3_PENDSV_PRIORITY  (0xFF)
 
+/* Debug exception & monitor ctrl reg. */
+#define CM3_DEMCR            (0xE000EDFC)
+#define CM3_DEMCR_TRCENA     (0x1<<24)       /* Enable DWT and ITM units.           */
+
+/* DWT cycle counter registers.        */
+#define CM3_DWT_CTRL         (0xE0001000)
+#define CM3_DWT_CYCCNTENA    (0x1<<0)        /* Enable cycle counter.               */
+#define CM3_DWT_CYCCNT       (0xE0001004)
+
+#if ((TCLC_TIMER_ENABLE) && (TCLC_TIMER_HRES_ENABLE))
+/* TIM2 is used as the one-shot alarm of the high resolution timers. */
+#define HRES_TIM_BASE        (0x40000000)
+#define HRES_TIM_CR1         (HRES_TIM_BASE + 0x00)
+#define HRES_TIM_CR1_CEN     (0x1<<0)        /* Counter enable.                     */
+#define HRES_TIM_CR1_URS     (0x1<<2)        /* Update request only on overflow.    */
+#define HRES_TIM_CR1_OPM     (0x1<<3)        /* One pulse mode.                     */
+#define HRES_TIM_DIER        (HRES_TIM_BASE + 0x0C)
+#define HRES_TIM_DIER_UIE    (0x1<<0)        /* Update interrupt enable.            */
+#define HRES_TIM_SR          (HRES_TIM_BASE + 0x10)
+#define HRES_TIM_EGR         (HRES_TIM_BASE + 0x14)
+#define HRES_TIM_EGR_UG      (0x1<<0)        /* Update generation.                  */
+#define HRES_TIM_CNT         (HRES_TIM_BASE + 0x24)
+#define HRES_TIM_PSC         (HRES_TIM_BASE + 0x28)
+#define HRES_TIM_ARR         (HRES_TIM_BASE + 0x2C)
+#define HRES_TIM_MAX_USECS   (0xFFFF)        /* 16 bits auto-reload register.       */
+#define HRES_TIM_IRQ_ID      (TIM2_IRQ_ID - WWDG_IRQ_ID) /* NVIC IRQn, IRQ_ID counts from 7. */
+
+/* TIM2 clock enable register.      */
+#define HRES_RCC_APB1ENR     (0x4002101C)
+#define HRES_RCC_TIMEN       (0x1<<0)
+
+/* NVIC interrupt set-enable register. */
+#define CM3_NVIC_ISER        (0xE000E100)
+#endif
+
 
 /*************************************************************************************************
  *  功能：启动内核节拍定时器                                                                     *
@@ -130,6 +166,74 @@ void CpuBuildThreadStack(TAddr32* pTop, void* pStack, TBase32 bytes,
 }
 
 
+/*************************************************************************************************
+ *  功能：读取处理器周期计数器                                                                   *
+ *  参数：无                                                                                     *
+ *  返回：处理器周期计数值                                                                       *
+ *  说明：DWT CYCCNT是32位自由运行计数器，溢出后自动回绕                                         *
+ *************************************************************************************************/
+TBase32 CpuGetCycleCount(void)
+{
+    return TCLM_GET_REG32(CM3_DWT_CYCCNT);
+}
+
+
+/*************************************************************************************************
+ *  功能：读取当前节拍内已经经过的处理器周期数                                                   *
+ *  参数：无                                                                                     *
+ *  返回：处理器周期数                                                                           *
+ *  说明：如果SysTick已经回绕但节拍中断尚未得到处理，返回值会包含这一个完整节拍                  *
+ *************************************************************************************************/
+TBase32 CpuGetTickCycles(void)
+{
+    TBase32 reload;
+    TBase32 cycles;
+
+    reload = TCLM_GET_REG32(CM3_SYSTICK_RELOAD) + 1U;
+    cycles = reload - 1U - TCLM_GET_REG32(CM3_SYSTICK_CURRENT);
+    if (TCLM_GET_REG32(CM3_ICSR) & CM3_ICSR_PENDSTSET)
+    {
+        cycles = reload - 1U - TCLM_GET_REG32(CM3_SYSTICK_CURRENT) + reload;
+    }
+
+    return cycles;
+}
+
+
+#if ((TCLC_TIMER_ENABLE) && (TCLC_TIMER_HRES_ENABLE))
+/*************************************************************************************************
+ *  功能：启动高精度定时器的硬件闹钟                                                             *
+ *  参数：(1) usecs 闹钟到时的微秒数                                                             *
+ *  返回：无                                                                                     *
+ *  说明：超过硬件计数范围的闹钟会提前到时，由内核重新启动闹钟                                   *
+ *************************************************************************************************/
+void CpuStartHrAlarm(TBase32 usecs)
+{
+    usecs = (usecs > HRES_TIM_MAX_USECS) ? HRES_TIM_MAX_USECS : usecs;
+    usecs = (usecs == 0U) ? 1U : usecs;
+
+    TCLM_SET_REG32(HRES_TIM_CR1, HRES_TIM_CR1_URS);
+    TCLM_SET_REG32(HRES_TIM_CNT, 0U);
+    TCLM_SET_REG32(HRES_TIM_ARR, usecs);
+    TCLM_SET_REG32(HRES_TIM_SR, 0U);
+    TCLM_SET_REG32(HRES_TIM_CR1, HRES_TIM_CR1_URS | HRES_TIM_CR1_OPM | HRES_TIM_CR1_CEN);
+}
+
+
+/*************************************************************************************************
+ *  功能：停止高精度定时器的硬件闹钟                                                             *
+ *  参数：无                                                                                     *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+void CpuStopHrAlarm(void)
+{
+    TCLM_SET_REG32(HRES_TIM_CR1, HRES_TIM_CR1_URS);
+    TCLM_SET_REG32(HRES_TIM_SR, 0U);
+}
+#endif
+
+
 /*************************************************************************************************
  *  功能：初始化处理器                                                                           *
  *  参数：无                                                                                     *
@@ -140,6 +244,24 @@ void CpuSetupEntry(void)
 {
     /* 配置PENDSV中断优先级 */
     TCLM_SET_REG32(CM3_PRIO_PENDSV, CM3_PENDSV_PRIORITY);
+
+#if ((TCLC_KERNEL_PROFILE_ENABLE) || (TCLC_THREAD_CYCLE_ENABLE))
+    /* 启动DWT周期计数器 */
+    TCLM_SET_REG32(CM3_DEMCR, TCLM_GET_REG32(CM3_DEMCR) | CM3_DEMCR_TRCENA);
+    TCLM_SET_REG32(CM3_DWT_CYCCNT, 0U);
+    TCLM_SET_REG32(CM3_DWT_CTRL, TCLM_GET_REG32(CM3_DWT_CTRL) | CM3_DWT_CYCCNTENA);
+#endif
+
+#if ((TCLC_TIMER_ENABLE) && (TCLC_TIMER_HRES_ENABLE))
+    /* 初始化高精度定时器的硬件闹钟，计数频率为1MHz */
+    TCLM_SET_REG32(HRES_RCC_APB1ENR, TCLM_GET_REG32(HRES_RCC_APB1ENR) | HRES_RCC_TIMEN);
+    TCLM_SET_REG32(HRES_TIM_CR1, HRES_TIM_CR1_URS);
+    TCLM_SET_REG32(HRES_TIM_PSC, TCLC_TIMER_HRES_CLOCK_FREQ / 1000000U - 1U);
+    TCLM_SET_REG32(HRES_TIM_EGR, HRES_TIM_EGR_UG);
+    TCLM_SET_REG32(HRES_TIM_SR, 0U);
+    TCLM_SET_REG32(HRES_TIM_DIER, HRES_TIM_DIER_UIE);
+    TCLM_SET_REG32(CM3_NVIC_ISER + ((HRES_TIM_IRQ_ID >> 5) << 2), 0x1U << (HRES_TIM_IRQ_ID & 0x1F));
+#endif
 }
 
 
@@ -181,7 +303,12 @@ void EXTI0_1_IRQHandler(void)
 /* 重写库函数 */
 void TIM2_IRQHandler(void)
 {
-#if (TCLC_IRQ_ENABLE)
+#if ((TCLC_TIMER_ENABLE) && (TCLC_TIMER_HRES_ENABLE))
+    TCLM_SET_REG32(HRES_TIM_SR, 0U);
+    xKernelEnterIntrState();
+    xTimerHresISR();
+    xKernelLeaveIntrState();
+#elif (TCLC_IRQ_ENABLE)
     xKernelEnterIntrState();
     xIrqEnterISR(TIM2_IRQ_ID);
     xKernelLeaveIntrState();
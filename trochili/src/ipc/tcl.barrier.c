@@ -0,0 +1,434 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#include <string.h>
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.cpu.h"
+#include "tcl.thread.h"
+#include "tcl.debug.h"
+#include "tcl.kernel.h"
+#include "tcl.ipc.h"
+#include "tcl.barrier.h"
+
+#if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_BARRIER_ENABLE))
+
+/*************************************************************************************************
+ *  功能: 等待屏障的线程被解除阻塞时的回调函数                                                   *
+ *  参数: (1) pContext   阻塞对象地址                                                            *
+ *        (2) state      线程等待屏障的结果                                                      *
+ *  返回: 无                                                                                     *
+ *  说明：线程超时或者被强制唤醒时立即撤销它在本轮的到达计数，而不是等到线程再次运行的时候，     *
+ *        否则屏障可能在这段时间里把已经离开的线程计算在内而提前放行                             *
+ *************************************************************************************************/
+static void BarrierWakeup(TIpcContext* pContext, TState state)
+{
+    TBarrier* pBarrier = (TBarrier*)(pContext->Object);
+
+    if ((state != eSuccess) && (pBarrier->Arrived > 0U))
+    {
+        pBarrier->Arrived--;
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程到达屏障并等待其它线程                                                             *
+ *  参数: (1) pBarrier   屏障结构地址                                                            *
+ *        (2) option     等待屏障的模式                                                          *
+ *        (3) timeo      时限阻塞模式下等待屏障的时限长度                                        *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：最后一个到达的线程一次唤醒全部等待线程，只做一次线程调度;                              *
+ *        等待超时或者被强制唤醒的线程在被唤醒的同时从本轮到达计数中退出                         *
+ *************************************************************************************************/
+TState xBarrierWait(TBarrier* pBarrier, TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TIpcContext context;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    /* 只允许在线程代码里调用本函数 */
+    if (uKernelVariable.State != eThreadState)
+    {
+        uKernelVariable.Diagnosis |= KERNEL_DIAG_IRQ_ERROR;
+        uDebugPanic("", __FILE__, __FUNCTION__, __LINE__);
+    }
+
+    if (pBarrier->Property & IPC_PROP_READY)
+    {
+        if (pBarrier->Arrived + 1U == pBarrier->Parties)
+        {
+            /* 最后一个线程到达，屏障进入下一轮并放行本轮全部线程 */
+            pBarrier->Arrived = 0U;
+            pBarrier->Phase++;
+            uIpcUnblockAll(&(pBarrier->Queue), eSuccess, IPC_ERR_NONE, (void**)0, &HiRP);
+
+            if ((uKernelVariable.SchedLockTimes == 0U) && (HiRP == eTrue))
+            {
+                uThreadSchedule();
+            }
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+        else if (uKernelVariable.SchedLockTimes != 0U)
+        {
+            error = IPC_ERR_NORMAL;
+        }
+        else if (!(uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK))
+        {
+            error = IPC_ERR_ACAPI;
+        }
+        else
+        {
+            pBarrier->Arrived++;
+
+            /* 设定线程正在等待的资源的信息 */
+            uIpcInitContext(&context, (void*)pBarrier, 0U, 0U,
+                            (option | IPC_OPT_WAIT | IPC_OPT_BARRIER), &state, &error);
+            context.Wakeup = BarrierWakeup;
+
+            /* 当前线程阻塞在该屏障的阻塞队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+            uIpcBlockThread(&context, &(pBarrier->Queue), timeo);
+
+            /* 当前线程被阻塞，其它线程得以执行 */
+            uThreadSchedule();
+
+            CpuLeaveCritical(imask);
+            /*
+             * 因为当前线程已经阻塞在IPC对象的线程阻塞队列，所以处理器需要执行别的线程。
+             * 当处理器再次处理本线程时，从本处继续运行。
+             */
+            CpuEnterCritical(&imask);
+
+            /* 清除线程挂起信息，本线程的到达计数已经在被唤醒时处理完毕 */
+            uIpcCleanContext(&context);
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 初始化屏障                                                                             *
+ *  参数: (1) pBarrier   屏障结构地址                                                            *
+ *        (2) pName      屏障名称                                                                *
+ *        (3) parties    每一轮需要到达屏障的线程数目                                            *
+ *        (4) property   屏障的初始属性                                                          *
+ *        (5) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：屏障只使用基本IPC队列                                                                  *
+ *************************************************************************************************/
+TState xBarrierCreate(TBarrier* pBarrier, TChar* pName, TBase32 parties, TProperty property,
+                      TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_FAULT;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (!(pBarrier->Property & IPC_PROP_READY))
+    {
+        /* 初始化屏障对象信息 */
+        uKernelAddObject(&(pBarrier->Object), pName, eBarrier, (void*)pBarrier);
+
+        /* 初始化屏障基本信息 */
+        property |= IPC_PROP_READY;
+        pBarrier->Property = property;
+        pBarrier->Parties  = parties;
+        pBarrier->Arrived  = 0U;
+        pBarrier->Phase    = 0U;
+        uIpcInitQueue(&(pBarrier->Queue), &(pBarrier->Property));
+
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 屏障删除                                                                               *
+ *  参数: (1) pBarrier   屏障结构地址                                                            *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xBarrierDelete(TBarrier* pBarrier, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TReg32 imask;
+    TBool HiRP = eFalse;
+
+    CpuEnterCritical(&imask);
+
+    if (pBarrier->Property & IPC_PROP_READY)
+    {
+        /* 将屏障阻塞队列上的所有等待线程都释放，所有线程的等待结果都是TCLE_IPC_DELETE */
+        uIpcUnblockAll(&(pBarrier->Queue), eFailure, IPC_ERR_DELETE, (void**)0, &HiRP);
+
+        /* 从内核中移除屏障 */
+        uKernelRemoveObject(&(pBarrier->Object));
+
+        /* 清除屏障对象的全部数据 */
+        memset(pBarrier, 0U, sizeof(TBarrier));
+
+        /*
+         * 在线程环境下，如果当前线程的优先级已经不再是线程就绪队列的最高优先级，
+         * 并且内核此时并没有关闭线程调度，那么就需要进行一次线程抢占
+         */
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR使门闩计数减1                                                                  *
+ *  参数: (1) pLatch     门闩结构地址                                                            *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：计数减到0时一次唤醒全部等待线程，只做一次线程调度。计数已经是0时返回失败               *
+ *************************************************************************************************/
+TState xLatchCountDown(TLatch* pLatch, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pLatch->Property & IPC_PROP_READY)
+    {
+        if (pLatch->Count == 0U)
+        {
+            error = IPC_ERR_NORMAL;
+        }
+        else
+        {
+            pLatch->Count--;
+            if (pLatch->Count == 0U)
+            {
+                uIpcUnblockAll(&(pLatch->Queue), eSuccess, IPC_ERR_NONE, (void**)0, &HiRP);
+
+                /* 如果当前线程解除了更高优先级线程的阻塞则进行调度。*/
+                if ((uKernelVariable.State == eThreadState) &&
+                        (uKernelVariable.SchedLockTimes == 0U) &&
+                        (HiRP == eTrue))
+                {
+                    uThreadSchedule();
+                }
+            }
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR等待门闩打开                                                                   *
+ *  参数: (1) pLatch     门闩结构地址                                                            *
+ *        (2) option     等待门闩的模式                                                          *
+ *        (3) timeo      时限阻塞模式下等待门闩的时限长度                                        *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：ISR只能以非阻塞方式查询门闩是否已经打开                                                *
+ *************************************************************************************************/
+TState xLatchWait(TLatch* pLatch, TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TIpcContext context;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pLatch->Property & IPC_PROP_READY)
+    {
+        if (pLatch->Count == 0U)
+        {
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = IPC_ERR_NORMAL;
+
+            /*
+             * 如果门闩还没有打开，并且采用的是等待方式，
+             * 那么当前线程必须阻塞在门闩的阻塞队列中
+             */
+            if ((uKernelVariable.State == eThreadState) &&
+                    (uKernelVariable.SchedLockTimes == 0U) &&
+                    (option & IPC_OPT_WAIT))
+            {
+                /* 如果当前线程不能被阻塞则函数直接返回 */
+                if (uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK)
+                {
+                    /* 设定线程正在等待的资源的信息 */
+                    uIpcInitContext(&context, (void*)pLatch, 0U, 0U,
+                                    option | IPC_OPT_LATCH, &state, &error);
+
+                    /* 当前线程阻塞在该门闩的阻塞队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+                    uIpcBlockThread(&context, &(pLatch->Queue), timeo);
+
+                    /* 当前线程被阻塞，其它线程得以执行 */
+                    uThreadSchedule();
+
+                    CpuLeaveCritical(imask);
+                    /*
+                     * 因为当前线程已经阻塞在IPC对象的线程阻塞队列，所以处理器需要执行别的线程。
+                     * 当处理器再次处理本线程时，从本处继续运行。
+                     */
+                    CpuEnterCritical(&imask);
+
+                    /* 清除线程挂起信息 */
+                    uIpcCleanContext(&context);
+                }
+                else
+                {
+                    error = IPC_ERR_ACAPI;
+                }
+            }
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 初始化门闩                                                                             *
+ *  参数: (1) pLatch     门闩结构地址                                                            *
+ *        (2) pName      门闩名称                                                                *
+ *        (3) count      门闩的初始计数                                                          *
+ *        (4) property   门闩的初始属性                                                          *
+ *        (5) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：门闩只使用基本IPC队列                                                                  *
+ *************************************************************************************************/
+TState xLatchCreate(TLatch* pLatch, TChar* pName, TBase32 count, TProperty property,
+                    TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_FAULT;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (!(pLatch->Property & IPC_PROP_READY))
+    {
+        /* 初始化门闩对象信息 */
+        uKernelAddObject(&(pLatch->Object), pName, eLatch, (void*)pLatch);
+
+        /* 初始化门闩基本信息 */
+        property |= IPC_PROP_READY;
+        pLatch->Property = property;
+        pLatch->Count    = count;
+        uIpcInitQueue(&(pLatch->Queue), &(pLatch->Property));
+
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 门闩删除                                                                               *
+ *  参数: (1) pLatch     门闩结构地址                                                            *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xLatchDelete(TLatch* pLatch, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TReg32 imask;
+    TBool HiRP = eFalse;
+
+    CpuEnterCritical(&imask);
+
+    if (pLatch->Property & IPC_PROP_READY)
+    {
+        /* 将门闩阻塞队列上的所有等待线程都释放，所有线程的等待结果都是TCLE_IPC_DELETE */
+        uIpcUnblockAll(&(pLatch->Queue), eFailure, IPC_ERR_DELETE, (void**)0, &HiRP);
+
+        /* 从内核中移除门闩 */
+        uKernelRemoveObject(&(pLatch->Object));
+
+        /* 清除门闩对象的全部数据 */
+        memset(pLatch, 0U, sizeof(TLatch));
+
+        /*
+         * 在线程环境下，如果当前线程的优先级已经不再是线程就绪队列的最高优先级，
+         * 并且内核此时并没有关闭线程调度，那么就需要进行一次线程抢占
+         */
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+#endif
+
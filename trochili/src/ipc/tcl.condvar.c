@@ -0,0 +1,351 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#include <string.h>
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.cpu.h"
+#include "tcl.thread.h"
+#include "tcl.debug.h"
+#include "tcl.kernel.h"
+#include "tcl.ipc.h"
+#include "tcl.mutex.h"
+#include "tcl.condvar.h"
+
+#if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_MUTEX_ENABLE)&&(TCLC_IPC_CONDVAR_ENABLE))
+
+/*************************************************************************************************
+ *  功能: 通知条件变量阻塞队列中的第一个线程                                                     *
+ *  参数: (1) pCondVar   条件变量结构地址                                                        *
+ *        (2) pHiRP      是否存在高就绪优先级标记                                                *
+ *  返回: 无                                                                                     *
+ *  说明：如果绑定的互斥量空闲，则唤醒线程并直接让它获得互斥量;否则把线程从条件变量的阻塞队列    *
+ *        直接转移到互斥量的阻塞队列，等互斥量被释放时再唤醒，避免线程被唤醒后马上又阻塞在互斥量 *
+ *        上。线程一旦被通知，就不再有等待时限                                                   *
+ *************************************************************************************************/
+static void SignalCondVar(TCondVar* pCondVar, TBool* pHiRP)
+{
+    TIpcContext* pContext;
+    TMutex* pMutex;
+    TThread* pThread;
+    TError error;
+
+    pMutex = pCondVar->Mutex;
+    pContext = (TIpcContext*)(pCondVar->Queue.PrimaryHandle->Owner);
+
+    if (!(pMutex->Property & IPC_PROP_READY))
+    {
+        uIpcUnblockThread(pContext, eFailure, IPC_ERR_UNREADY, pHiRP);
+    }
+    else if (pMutex->Owner == (TThread*)0)
+    {
+        uIpcUnblockThread(pContext, eSuccess, IPC_ERR_NONE, pHiRP);
+
+        pThread = (TThread*)(pContext->Owner);
+        uMutexGrant(pMutex, pThread, pHiRP, &error);
+    }
+    else
+    {
+        uIpcMoveThread(pContext, &(pMutex->Queue), (void*)pMutex,
+                       (pContext->Option & (~(IPC_OPT_CONDVAR | IPC_OPT_TIMEO))) | IPC_OPT_MUTEX);
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程在条件变量上等待                                                                   *
+ *  参数: (1) pCondVar   条件变量结构地址                                                        *
+ *        (2) option     等待条件变量的模式                                                      *
+ *        (3) timeo      时限阻塞模式下等待条件变量的时限长度                                    *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：当前线程必须已经占有条件变量绑定的互斥量。释放互斥量和线程阻塞在条件变量上是在同一个   *
+ *        临界区里完成的，不会丢失通知。不管等待结果如何，函数返回时线程都重新占有互斥量,        *
+ *        互斥量的嵌套深度也恢复原值                                                             *
+ *************************************************************************************************/
+TState xCondVarWait(TCondVar* pCondVar, TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TState lstate;
+    TError lerror;
+    TBool HiRP = eFalse;
+    TBase32 nest = 1U;
+    TMutex* pMutex;
+    TThread* pThread;
+    TIpcContext context;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    /* 只允许在线程代码里调用本函数 */
+    if (uKernelVariable.State != eThreadState)
+    {
+        uKernelVariable.Diagnosis |= KERNEL_DIAG_IRQ_ERROR;
+        uDebugPanic("", __FILE__, __FUNCTION__, __LINE__);
+    }
+
+    if (pCondVar->Property & IPC_PROP_READY)
+    {
+        pMutex = pCondVar->Mutex;
+        pThread = uKernelVariable.CurrentThread;
+
+        /* 当前线程必须占有互斥量，并且能够被阻塞 */
+        if ((pMutex->Owner != pThread) || (uKernelVariable.SchedLockTimes != 0U))
+        {
+            error = IPC_ERR_NORMAL;
+        }
+        else if (!(pThread->ACAPI & THREAD_ACAPI_BLOCK))
+        {
+            error = IPC_ERR_ACAPI;
+        }
+        else
+        {
+            /* 彻底释放互斥量，互斥量可能被直接交给在互斥量上等待的线程，当前线程的优先级也可能被恢复 */
+            uMutexRelease(pMutex, &nest, &HiRP, &lerror);
+
+            /* 设定线程正在等待的资源的信息 */
+            uIpcInitContext(&context, (void*)pCondVar, 0U, 0U,
+                            (option | IPC_OPT_WAIT | IPC_OPT_CONDVAR), &state, &error);
+
+            /* 当前线程阻塞在该条件变量的阻塞队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+            uIpcBlockThread(&context, &(pCondVar->Queue), timeo);
+
+            /* 当前线程被阻塞，其它线程得以执行 */
+            uThreadSchedule();
+
+            CpuLeaveCritical(imask);
+            /*
+             * 因为当前线程已经阻塞在IPC对象的线程阻塞队列，所以处理器需要执行别的线程。
+             * 当处理器再次处理本线程时，从本处继续运行。
+             */
+            CpuEnterCritical(&imask);
+
+            /* 清除线程挂起信息 */
+            uIpcCleanContext(&context);
+
+            /*
+             * 等待超时、条件变量被删除或者线程被强制唤醒时，线程并没有得到互斥量，
+             * 此时需要以永久阻塞的方式重新获得互斥量
+             */
+            while ((pMutex->Property & IPC_PROP_READY) && (pMutex->Owner != pThread))
+            {
+                if (uMutexGrant(pMutex, pThread, &HiRP, &lerror) == eFailure)
+                {
+                    uIpcInitContext(&context, (void*)pMutex, 0U, 0U,
+                                    (IPC_OPT_WAIT | IPC_OPT_MUTEX), &lstate, &lerror);
+                    uIpcBlockThread(&context, &(pMutex->Queue), 0U);
+                    uThreadSchedule();
+
+                    CpuLeaveCritical(imask);
+                    CpuEnterCritical(&imask);
+
+                    uIpcCleanContext(&context);
+                }
+            }
+
+            /* 恢复互斥量的嵌套深度 */
+            if (pMutex->Owner == pThread)
+            {
+                pMutex->Nest = nest;
+            }
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 通知一个在条件变量上等待的线程                                                         *
+ *  参数: (1) pCondVar   条件变量结构地址                                                        *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：没有线程等待时通知不会被记录                                                           *
+ *************************************************************************************************/
+TState xCondVarSignal(TCondVar* pCondVar, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    /* 只允许在线程代码里调用本函数 */
+    if (uKernelVariable.State != eThreadState)
+    {
+        uKernelVariable.Diagnosis |= KERNEL_DIAG_IRQ_ERROR;
+        uDebugPanic("", __FILE__, __FUNCTION__, __LINE__);
+    }
+
+    if (pCondVar->Property & IPC_PROP_READY)
+    {
+        if (pCondVar->Property & IPC_PROP_PRIMQ_AVAIL)
+        {
+            SignalCondVar(pCondVar, &HiRP);
+        }
+
+        /* 如果当前线程解除了更高优先级线程的阻塞则进行调度。*/
+        if ((uKernelVariable.SchedLockTimes == 0U) && (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 通知全部在条件变量上等待的线程                                                         *
+ *  参数: (1) pCondVar   条件变量结构地址                                                        *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：最多只有一个线程被唤醒并获得互斥量，其余线程被转移到互斥量的阻塞队列中依次获得互斥量   *
+ *************************************************************************************************/
+TState xCondVarBroadcast(TCondVar* pCondVar, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    /* 只允许在线程代码里调用本函数 */
+    if (uKernelVariable.State != eThreadState)
+    {
+        uKernelVariable.Diagnosis |= KERNEL_DIAG_IRQ_ERROR;
+        uDebugPanic("", __FILE__, __FUNCTION__, __LINE__);
+    }
+
+    if (pCondVar->Property & IPC_PROP_READY)
+    {
+        while (pCondVar->Property & IPC_PROP_PRIMQ_AVAIL)
+        {
+            SignalCondVar(pCondVar, &HiRP);
+        }
+
+        /* 如果当前线程解除了更高优先级线程的阻塞则进行调度。*/
+        if ((uKernelVariable.SchedLockTimes == 0U) && (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 初始化条件变量                                                                         *
+ *  参数: (1) pCondVar   条件变量结构地址                                                        *
+ *        (2) pName      条件变量名称                                                            *
+ *        (3) pMutex     条件变量绑定的互斥量                                                    *
+ *        (4) property   条件变量的初始属性                                                      *
+ *        (5) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：条件变量只使用基本IPC队列                                                              *
+ *************************************************************************************************/
+TState xCondVarCreate(TCondVar* pCondVar, TChar* pName, TMutex* pMutex, TProperty property,
+                      TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_FAULT;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if ((!(pCondVar->Property & IPC_PROP_READY)) && (pMutex->Property & IPC_PROP_READY))
+    {
+        /* 初始化条件变量对象信息 */
+        uKernelAddObject(&(pCondVar->Object), pName, eCondVar, (void*)pCondVar);
+
+        /* 初始化条件变量基本信息 */
+        property |= IPC_PROP_READY;
+        pCondVar->Property = property;
+        pCondVar->Mutex    = pMutex;
+        uIpcInitQueue(&(pCondVar->Queue), &(pCondVar->Property));
+
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 条件变量删除                                                                           *
+ *  参数: (1) pCondVar   条件变量结构地址                                                        *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：被唤醒的线程重新获得互斥量之后才返回，等待结果都是TCLE_IPC_DELETE                      *
+ *************************************************************************************************/
+TState xCondVarDelete(TCondVar* pCondVar, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TReg32 imask;
+    TBool HiRP = eFalse;
+
+    CpuEnterCritical(&imask);
+
+    if (pCondVar->Property & IPC_PROP_READY)
+    {
+        /* 将条件变量阻塞队列上的所有等待线程都释放，所有线程的等待结果都是TCLE_IPC_DELETE */
+        uIpcUnblockAll(&(pCondVar->Queue), eFailure, IPC_ERR_DELETE, (void**)0, &HiRP);
+
+        /* 从内核中移除条件变量 */
+        uKernelRemoveObject(&(pCondVar->Object));
+
+        /* 清除条件变量对象的全部数据 */
+        memset(pCondVar, 0U, sizeof(TCondVar));
+
+        /*
+         * 在线程环境下，如果当前线程的优先级已经不再是线程就绪队列的最高优先级，
+         * 并且内核此时并没有关闭线程调度，那么就需要进行一次线程抢占
+         */
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+#endif
+
@@ -295,9 +295,7 @@ TState xFlagsCreate(TFlags* pFlags, TChar* pName, TProperty property, TError* pE
         pFlags->Property = property;
         pFlags->Value = 0U;
 
-        pFlags->Queue.PrimaryHandle   = (TLinkNode*)0;
-        pFlags->Queue.AuxiliaryHandle = (TLinkNode*)0;
-        pFlags->Queue.Property        = &(pFlags->Property);
+        uIpcInitQueue(&(pFlags->Queue), &(pFlags->Property));
 
         state = eSuccess;
         error = IPC_ERR_NONE;
@@ -449,5 +447,534 @@ TState xFlagsFlush(TFlags* pFlags, TError* pError)
     return state;
 }
 
+
+#if (TCLC_IPC_FLAGS64_ENABLE)
+/*************************************************************************************************
+ *  功能：计算64位事件组中最低的有效位                                                           *
+ *  参数：(1) mask     事件组，不能为0                                                           *
+ *  返回：最低有效位的位号                                                                       *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+static TIndex LowestBit64(TBitMask64 mask)
+{
+    TIndex index;
+
+    if ((TBitMask)mask != 0U)
+    {
+        index = CpuCalcHiPRIO((TBitMask)mask);
+    }
+    else
+    {
+        index = 32U + CpuCalcHiPRIO((TBitMask)(mask >> 32));
+    }
+    return index;
+}
+
+
+/*************************************************************************************************
+ *  功能：计算等待线程的触发位，即只有该位被置位时线程才有可能得到满足                           *
+ *  参数：(1) value    事件标记的当前事件组                                                      *
+ *        (2) pattern  线程等待的事件组合                                                        *
+ *        (3) option   访问事件标记的参数                                                        *
+ *  返回：等待桶编号                                                                             *
+ *  说明：AND等待使用任一尚未发生的事件位，多位OR等待无法用一个位索引，放入最后一个等待桶        *
+ *************************************************************************************************/
+static TIndex TriggerBucket(TBitMask64 value, TBitMask64 pattern, TOption option)
+{
+    TIndex bucket;
+
+    if (option & IPC_OPT_AND)
+    {
+        bucket = LowestBit64(pattern & (~value));
+    }
+    else if ((pattern & (pattern - 1U)) == 0U)
+    {
+        bucket = LowestBit64(pattern);
+    }
+    else
+    {
+        bucket = FLAGS64_SCATTER;
+    }
+    return bucket;
+}
+
+
+/*************************************************************************************************
+ *  功能：把等待节点放入等待桶                                                                   *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pNode    等待节点地址                                                              *
+ *        (3) bucket   等待桶编号                                                                *
+ *  返回：无                                                                                     *
+ *  说明：桶内按照节点的排序值排列，排序值是线程优先级或者等待顺序号，和阻塞队列的策略一致
+ *************************************************************************************************/
+static void IndexWaiter(TFlags64* pFlags, TLinkNode* pNode, TIndex bucket)
+{
+    uObjQueueAddPriorityNode(&(pFlags->Buckets[bucket]), pNode);
+    if (bucket < FLAGS64_SCATTER)
+    {
+        pFlags->BucketMask |= ((TBitMask64)0x1 << bucket);
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：把等待节点从所在的等待桶中移出                                                         *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pNode    等待节点地址                                                              *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+static void UnindexWaiter(TFlags64* pFlags, TLinkNode* pNode)
+{
+    TIndex bucket;
+
+    bucket = (TIndex)(pNode->Handle - pFlags->Buckets);
+    uObjQueueRemoveNode(pNode->Handle, pNode);
+    if ((bucket < FLAGS64_SCATTER) && (pFlags->Buckets[bucket] == (TLinkNode*)0))
+    {
+        pFlags->BucketMask &= ~((TBitMask64)0x1 << bucket);
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：线程被解除阻塞时把它的等待节点移出等待桶
+ *  参数：(1) pContext 线程的IPC阻塞信息
+ *        (2) state    线程的等待结果
+ *  返回：无
+ *  说明：线程因为超时、中止、删除等原因被唤醒时节点还在等待桶里，必须在线程离开阻塞队列时
+ *        立即移出，否则事件发送时会访问到已经不再等待的线程
+ *************************************************************************************************/
+static void Flags64Wakeup(TIpcContext* pContext, TState state)
+{
+    TFlags64Waiter* pWaiter;
+
+    pWaiter = (TFlags64Waiter*)pContext;
+    if (pWaiter->Node.Handle != (TLinkNode**)0)
+    {
+        UnindexWaiter((TFlags64*)(pContext->Object), &(pWaiter->Node));
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：阻塞线程的优先级被修改时调整它在等待桶中的位置
+ *  参数：(1) pContext 线程的IPC阻塞信息
+ *  返回：无
+ *  说明：只有按优先级排序的等待桶需要调整，节点的排序值直接指向线程的优先级
+ *************************************************************************************************/
+static void Flags64Reorder(TIpcContext* pContext)
+{
+    TFlags64Waiter* pWaiter;
+    TLinkNode** pHandle2;
+
+    pWaiter = (TFlags64Waiter*)pContext;
+    pHandle2 = pWaiter->Node.Handle;
+    if ((pHandle2 != (TLinkNode**)0) &&
+            (((TFlags64*)(pContext->Object))->Property & IPC_PROP_PREEMP_PRIMIQ))
+    {
+        uObjQueueRemoveNode(pHandle2, &(pWaiter->Node));
+        uObjQueueAddPriorityNode(pHandle2, &(pWaiter->Node));
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：把一个等待桶中的全部线程移入待检查链表
+ *  参数：(1) pFlags   事件标记的地址
+ *        (2) bucket   等待桶编号
+ *        (3) pList2   待检查链表
+ *  返回：无
+ *  说明：待检查链表按照节点的排序值排列，多个等待桶中的线程合并后按照阻塞队列的策略依次检查
+ *************************************************************************************************/
+static void CollectBucket(TFlags64* pFlags, TIndex bucket, TLinkNode** pList2)
+{
+    TLinkNode* pNode;
+
+    while (pFlags->Buckets[bucket] != (TLinkNode*)0)
+    {
+        pNode = pFlags->Buckets[bucket];
+        UnindexWaiter(pFlags, pNode);
+        uObjQueueAddPriorityNode(pList2, pNode);
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：线程/ISR接收64位事件标记                                                               *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pPattern 需要接收的标记的组合                                                      *
+ *        (3) option   访问事件标记的参数                                                        *
+ *        (4) timeo    时限阻塞模式下访问事件标记的时限长度                                      *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xFlags64Receive(TFlags64* pFlags, TBitMask64* pPattern, TOption option, TTimeTick timeo,
+                       TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TFlags64Waiter waiter;
+    TBitMask64 match;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pFlags->Property & IPC_PROP_READY)
+    {
+        error = IPC_ERR_NORMAL;
+        match = (pFlags->Value) & (*pPattern);
+        if (((option & IPC_OPT_AND) && (match == *pPattern)) ||
+                ((option & IPC_OPT_OR) && (match != 0U)))
+        {
+            if (option & IPC_OPT_CONSUME)
+            {
+                pFlags->Value &= (~match);
+            }
+            *pPattern = match;
+
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            if ((uKernelVariable.State == eThreadState) &&
+                    (uKernelVariable.SchedLockTimes == 0U) &&
+                    (option & IPC_OPT_WAIT))
+            {
+                /* 如果当前线程不能被阻塞则函数直接返回 */
+                if (uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK)
+                {
+                    /* 保存线程挂起信息 */
+                    uIpcInitContext(&(waiter.Context), (void*)pFlags, (TBase32)pPattern,
+                                    sizeof(TBitMask64), option | IPC_OPT_FLAGS, &state, &error);
+                    waiter.Context.Wakeup = Flags64Wakeup;
+                    waiter.Context.Reorder = Flags64Reorder;
+
+                    /* 当前线程阻塞在该事件标记的阻塞队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+                    uIpcBlockThread(&(waiter.Context), &(pFlags->Queue), timeo);
+
+                    /* 按照触发位把当前线程放入等待桶，桶内次序和阻塞队列的策略一致 */
+                    memset(&(waiter.Node), 0U, sizeof(TLinkNode));
+                    waiter.Node.Owner = (void*)(&(waiter.Context));
+                    if (pFlags->Property & IPC_PROP_PREEMP_PRIMIQ)
+                    {
+                        waiter.Node.Data = (TBase32*)(&(uKernelVariable.CurrentThread->Priority));
+                    }
+                    else
+                    {
+                        waiter.Ticket = pFlags->Tickets++;
+                        waiter.Node.Data = &(waiter.Ticket);
+                    }
+                    IndexWaiter(pFlags, &(waiter.Node), TriggerBucket(pFlags->Value, *pPattern, option));
+
+                    /* 当前线程被阻塞，其它线程得以执行 */
+                    uThreadSchedule();
+
+                    CpuLeaveCritical(imask);
+                    /*
+                     * 因为当前线程已经阻塞在IPC对象的线程阻塞队列，所以处理器需要执行别的线程。
+                     * 当处理器再次处理本线程时，从本处继续运行。
+                     */
+                    CpuEnterCritical(&imask);
+
+                    /* 清除线程IPC阻塞信息 */
+                    uIpcCleanContext(&(waiter.Context));
+                }
+                else
+                {
+                    error = IPC_ERR_ACAPI;
+                }
+            }
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：线程/ISR向64位事件标记发送事件                                                         *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pattern  需要发送的标记的组合                                                      *
+ *        (3) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：只检查触发位属于新发生事件的等待线程和多位OR等待线程                                   *
+ *************************************************************************************************/
+TState xFlags64Send(TFlags64* pFlags, TBitMask64 pattern, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TBitMask64 fresh;
+    TBitMask64 mask;
+    TBitMask64* pTemp;
+    TIndex bucket;
+    TLinkNode* pList = (TLinkNode*)0;
+    TLinkNode* pNode;
+    TIpcContext* pContext;
+    TOption option;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pFlags->Property & IPC_PROP_READY)
+    {
+        /* 检查事件是否需要发送 */
+        fresh = pattern & (~pFlags->Value);
+        if (fresh != 0U)
+        {
+            pFlags->Value |= pattern;
+
+            /* 只收集触发位刚刚被置位的等待桶和多位OR等待桶 */
+            fresh &= pFlags->BucketMask;
+            while (fresh != 0U)
+            {
+                bucket = LowestBit64(fresh);
+                fresh &= ~((TBitMask64)0x1 << bucket);
+                CollectBucket(pFlags, bucket, &pList);
+            }
+            CollectBucket(pFlags, FLAGS64_SCATTER, &pList);
+
+            /*
+             * 按照阻塞队列的策略依次检查收集到的线程，保证IPC_OPT_CONSUME消耗的事件总是
+             * 先满足优先级高(或者先开始等待)的线程；得不到满足的线程按照新的触发位重新放入等待桶
+             */
+            while (pList != (TLinkNode*)0)
+            {
+                pNode = pList;
+                uObjQueueRemoveNode(&pList, pNode);
+
+                pContext = (TIpcContext*)(pNode->Owner);
+                option = pContext->Option;
+                pTemp = (TBitMask64*)(pContext->Data.Addr1);
+                mask = pFlags->Value & (*pTemp);
+                if (((option & IPC_OPT_AND) && (mask == *pTemp)) ||
+                        ((option & IPC_OPT_OR) && (mask != 0U)))
+                {
+                    *pTemp = mask;
+                    uIpcUnblockThread(pContext, eSuccess, IPC_ERR_NONE, &HiRP);
+
+                    if (option & IPC_OPT_CONSUME)
+                    {
+                        pFlags->Value &= (~mask);
+                    }
+                }
+                else
+                {
+                    IndexWaiter(pFlags, pNode, TriggerBucket(pFlags->Value, *pTemp, option));
+                }
+            }
+
+            if ((uKernelVariable.State == eThreadState) &&
+                    (uKernelVariable.SchedLockTimes == 0U) &&
+                    (HiRP == eTrue))
+            {
+                uThreadSchedule();
+            }
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = IPC_ERR_NORMAL;
+            state = eError;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：初始化64位事件标记                                                                     *
+ *  参数：(1) pFlags     事件标记的地址                                                          *
+ *        (2) pName      事件标记的名称                                                          *
+ *        (3) property   事件标记的初始属性                                                      *
+ *        (4) pError     函数调用详细返回值                                                      *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xFlags64Create(TFlags64* pFlags, TChar* pName, TProperty property, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_FAULT;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (!(pFlags->Property & IPC_PROP_READY))
+    {
+        /* 初始化事件标记对象信息 */
+        uKernelAddObject(&(pFlags->Object), pName, eFlag64, (void*)pFlags);
+
+        /* 初始化事件标记基本信息 */
+        property |= IPC_PROP_READY;
+        pFlags->Property = property;
+        pFlags->Value = (TBitMask64)0;
+        pFlags->BucketMask = (TBitMask64)0;
+        pFlags->Tickets = 0U;
+        memset(pFlags->Buckets, 0, sizeof(pFlags->Buckets));
+
+        uIpcInitQueue(&(pFlags->Queue), &(pFlags->Property));
+
+        state = eSuccess;
+        error = IPC_ERR_NONE;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：取消64位事件标记初始化                                                                 *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pError   函数调用详细返回值                                                        *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xFlags64Delete(TFlags64* pFlags, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TReg32 imask;
+    TBool HiRP = eFalse;
+
+    CpuEnterCritical(&imask);
+
+    if (pFlags->Property & IPC_PROP_READY)
+    {
+        /* 将阻塞队列上的所有等待线程都释放，所有线程的等待结果都是IPC_ERR_DELETE  */
+        uIpcUnblockAll(&(pFlags->Queue), eFailure, IPC_ERR_DELETE, (void**)0, &HiRP);
+
+        /* 从内核中移除事件标记对象 */
+        uKernelRemoveObject(&(pFlags->Object));
+
+        /* 清除事件标记对象的全部数据 */
+        memset(pFlags, 0U, sizeof(TFlags64));
+
+        /*
+         * 在线程环境下，如果当前线程的优先级已经不再是线程就绪队列的最高优先级，
+         * 并且内核此时并没有关闭线程调度，那么就需要进行一次线程抢占
+         */
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        state = eSuccess;
+        error = IPC_ERR_NONE;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 重置64位事件标记                                                                       *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xFlags64Reset(TFlags64* pFlags, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TReg32 imask;
+    TBool HiRP = eFalse;
+
+    CpuEnterCritical(&imask);
+
+    if (pFlags->Property & IPC_PROP_READY)
+    {
+        /* 将阻塞队列上的所有等待线程都释放，所有线程的等待结果都是IPC_ERR_RESET */
+        uIpcUnblockAll(&(pFlags->Queue), eFailure, IPC_ERR_RESET, (void**)0, &HiRP);
+
+        pFlags->Property &= IPC_RESET_FLAG_PROP;
+        pFlags->Value = (TBitMask64)0;
+
+        /*
+         * 在线程环境下，如果当前线程的优先级已经不再是线程就绪队列的最高优先级，
+         * 并且内核此时并没有关闭线程调度，那么就需要进行一次线程抢占
+         */
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        state = eSuccess;
+        error = IPC_ERR_NONE;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：释放64位事件标记阻塞队列上的全部线程                                                   *
+ *  参数：(1) pFlags   事件标记结构地址                                                          *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess                                                                           *
+ *        (2) eFailure                                                                           *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xFlags64Flush(TFlags64* pFlags, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TReg32 imask;
+    TBool HiRP = eFalse;
+
+    CpuEnterCritical(&imask);
+
+    if (pFlags->Property & IPC_PROP_READY)
+    {
+        /* 将事件标记阻塞队列上的所有等待线程都释放，所有线程的等待结果都是TCLE_IPC_FLUSH  */
+        uIpcUnblockAll(&(pFlags->Queue), eFailure, IPC_ERR_FLUSH, (void**)0, &HiRP);
+
+        /*
+         * 在线程环境下，如果当前线程的优先级已经不再是线程就绪队列的最高优先级，
+         * 并且内核此时并没有关闭线程调度，那么就需要进行一次线程抢占
+         */
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        state = eSuccess;
+        error = IPC_ERR_NONE;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
 #endif
 
+#endif
@@ -3,9 +3,12 @@
  *                                  Copyright(C) 2016 LIUXUMING                                  *
  *                                       www.trochili.com                                        *
  *************************************************************************************************/
+#include <string.h>
+
 #include "tcl.types.h"
 #include "tcl.config.h"
 #include "tcl.object.h"
+#include "tcl.cpu.h"
 #include "tcl.debug.h"
 #include "tcl.kernel.h"
 #include "tcl.timer.h"
@@ -14,6 +17,109 @@
 
 #if (TCLC_IPC_ENABLE)
 
+#if (TCLC_IPC_QUEUE_O1_ENABLE)
+/*************************************************************************************************
+ *  功能：按照优先级将线程加入IPC线程阻塞分队列                                                  *
+ *  参数：(1) pHandle2 分队列头指针的地址                                                        *
+ *        (2) pMask    分队列优先级掩码的地址                                                    *
+ *        (3) pHeads   分队列各优先级分组首节点数组                                              *
+ *        (4) pContext 阻塞对象地址                                                              *
+ *  返回：无                                                                                     *
+ *  说明：新节点插在第一个更低优先级分组的首节点之前，也就是同优先级分组的末尾，                 *
+ *        不需要遍历队列                                                                         *
+ *************************************************************************************************/
+static void AddPriorityContext(TLinkNode** pHandle2, TBitMask* pMask, TLinkNode** pHeads,
+                               TIpcContext* pContext)
+{
+    TLinkNode* pNode = &(pContext->LinkNode);
+    TLinkNode* pNext;
+    TPriority  priority;
+    TBitMask   lower;
+
+    KNL_ASSERT((pNode->Handle == (TLinkNode**)0), "");
+
+    /* 记下入队时的优先级，线程优先级被修改之后仍然能找到节点所在的分组 */
+    priority = *(pNode->Data);
+    pContext->Priority = priority;
+
+    /* 找到第一个更低优先级的分组，没有则插在整个队列的末尾，也就是头节点之前 */
+    lower = (*pMask) & (~((((TBitMask)0x1 << priority) << 1U) - 1U));
+    if (lower != (TBitMask)0)
+    {
+        pNext = pHeads[CpuCalcHiPRIO(lower)];
+    }
+    else
+    {
+        pNext = *pHandle2;
+    }
+
+    if (!((*pMask) & ((TBitMask)0x1 << priority)))
+    {
+        pHeads[priority] = pNode;
+        *pMask |= ((TBitMask)0x1 << priority);
+    }
+
+    if (pNext == (TLinkNode*)0)
+    {
+        *pHandle2 = pNode;
+        pNode->Prev = pNode;
+        pNode->Next = pNode;
+    }
+    else
+    {
+        pNode->Prev = pNext->Prev;
+        pNode->Prev->Next = pNode;
+        pNode->Next = pNext;
+        pNode->Next->Prev = pNode;
+
+        /* 插在第一个分组之前说明新节点的优先级最高 */
+        if ((lower != (TBitMask)0) && (pNext == *pHandle2))
+        {
+            *pHandle2 = pNode;
+        }
+    }
+    pNode->Handle = pHandle2;
+}
+
+
+/*************************************************************************************************
+ *  功能：将线程从按照优先级排序的IPC线程阻塞分队列中移出                                        *
+ *  参数：(1) pHandle2 分队列头指针的地址                                                        *
+ *        (2) pMask    分队列优先级掩码的地址                                                    *
+ *        (3) pHeads   分队列各优先级分组首节点数组                                              *
+ *        (4) pContext 阻塞对象地址                                                              *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+static void RemovePriorityContext(TLinkNode** pHandle2, TBitMask* pMask, TLinkNode** pHeads,
+                                  TIpcContext* pContext)
+{
+    TLinkNode* pNode = &(pContext->LinkNode);
+    TLinkNode* pNext;
+    TPriority  priority;
+
+    /* 如果节点是分组的首节点，分组里的下一个节点成为新的首节点，否则分组变空 */
+    priority = pContext->Priority;
+    if (pHeads[priority] == pNode)
+    {
+        pNext = pNode->Next;
+        if ((pNext != *pHandle2) &&
+                (((TIpcContext*)(pNext->Owner))->Priority == priority))
+        {
+            pHeads[priority] = pNext;
+        }
+        else
+        {
+            pHeads[priority] = (TLinkNode*)0;
+            *pMask &= ~((TBitMask)0x1 << priority);
+        }
+    }
+
+    uObjQueueRemoveNode(pHandle2, pNode);
+}
+#endif
+
+
 /*************************************************************************************************
  *  功能：将线程加入到指定的IPC线程阻塞队列中                                                    *
  *  参数：(1) pQueue   IPC队列地址                                                               *
@@ -30,7 +136,12 @@ static void EnterBlockedQueue(TIpcQueue* pQueue, TIpcContext* pContext)
     {
         if (property &IPC_PROP_PREEMP_AUXIQ)
         {
+#if (TCLC_IPC_QUEUE_O1_ENABLE)
+            AddPriorityContext(&(pQueue->AuxiliaryHandle), &(pQueue->AuxiliaryMask),
+                               pQueue->AuxiliaryHeads, pContext);
+#else
             uObjQueueAddPriorityNode(&(pQueue->AuxiliaryHandle), &(pContext->LinkNode));
+#endif
         }
         else
         {
@@ -42,7 +153,12 @@ static void EnterBlockedQueue(TIpcQueue* pQueue, TIpcContext* pContext)
     {
         if (property &IPC_PROP_PREEMP_PRIMIQ)
         {
+#if (TCLC_IPC_QUEUE_O1_ENABLE)
+            AddPriorityContext(&(pQueue->PrimaryHandle), &(pQueue->PrimaryMask),
+                               pQueue->PrimaryHeads, pContext);
+#else
             uObjQueueAddPriorityNode(&(pQueue->PrimaryHandle), &(pContext->LinkNode));
+#endif
         }
         else
         {
@@ -74,7 +190,19 @@ static void LeaveBlockedQueue(TIpcQueue* pQueue, TIpcContext* pContext)
     /* 将线程从指定的分队列中取出 */
     if ((pContext->Option) & IPC_OPT_USE_AUXIQ)
     {
+#if (TCLC_IPC_QUEUE_O1_ENABLE)
+        if (property & IPC_PROP_PREEMP_AUXIQ)
+        {
+            RemovePriorityContext(&(pQueue->AuxiliaryHandle), &(pQueue->AuxiliaryMask),
+                                  pQueue->AuxiliaryHeads, pContext);
+        }
+        else
+        {
+            uObjQueueRemoveNode(&(pQueue->AuxiliaryHandle), &(pContext->LinkNode));
+        }
+#else
         uObjQueueRemoveNode(&(pQueue->AuxiliaryHandle), &(pContext->LinkNode));
+#endif
         if (pQueue->AuxiliaryHandle == (TLinkNode*)0)
         {
             property &= ~IPC_PROP_AUXIQ_AVAIL;
@@ -82,7 +210,19 @@ static void LeaveBlockedQueue(TIpcQueue* pQueue, TIpcContext* pContext)
     }
     else
     {
+#if (TCLC_IPC_QUEUE_O1_ENABLE)
+        if (property & IPC_PROP_PREEMP_PRIMIQ)
+        {
+            RemovePriorityContext(&(pQueue->PrimaryHandle), &(pQueue->PrimaryMask),
+                                  pQueue->PrimaryHeads, pContext);
+        }
+        else
+        {
+            uObjQueueRemoveNode(&(pQueue->PrimaryHandle), &(pContext->LinkNode));
+        }
+#else
         uObjQueueRemoveNode(&(pQueue->PrimaryHandle), &(pContext->LinkNode));
+#endif
         if (pQueue->PrimaryHandle == (TLinkNode*)0)
         {
             property &= ~IPC_PROP_PRIMQ_AVAIL;
@@ -184,6 +324,12 @@ void uIpcUnblockThread(TIpcContext* pContext, TState state, TError error, TBool*
     /* 将线程从阻塞队列移出 */
     LeaveBlockedQueue(pContext->Queue, pContext);
 
+    /* 通知IPC对象线程已经被解除阻塞 */
+    if (pContext->Wakeup != (TIpcWakeup)0)
+    {
+        pContext->Wakeup(pContext, state);
+    }
+
     /* 设置线程访问资源的结果和错误代码 */
     *(pContext->State) = state;
     *(pContext->Error) = error;
@@ -200,13 +346,53 @@ void uIpcUnblockThread(TIpcContext* pContext, TState state, TError error, TBool*
      * 在线程环境下，如果当前线程的优先级已经不再是线程就绪队列的最高优先级，
      * 并且内核此时并没有关闭线程调度，那么就需要进行一次线程抢占
      */
-    if (pThread->Priority < uKernelVariable.CurrentThread->Priority)
+    if (uThreadCheckPreempt(pThread) == eTrue)
     {
         *pHiRP = eTrue;
     }
 }
 
 
+/*************************************************************************************************
+ *  功能：把阻塞线程从当前IPC阻塞队列直接转移到另一个IPC阻塞队列                                 *
+ *  参数：(1) pContext 阻塞对象地址                                                              *
+ *        (2) pQueue   新的线程阻塞队列地址                                                      *
+ *        (3) pIpc     新的IPC对象的地址                                                         *
+ *        (4) option   线程在新的IPC对象上的操作参数                                             *
+ *  返回：无                                                                                     *
+ *  说明：线程始终保持阻塞状态，不会被唤醒，如果新的操作参数不再包含IPC_OPT_TIMEO，              *
+ *        则停止线程的时限定时器                                                                 *
+ *************************************************************************************************/
+void uIpcMoveThread(TIpcContext* pContext, TIpcQueue* pQueue, void* pIpc, TOption option)
+{
+    TThread* pThread;
+    pThread = (TThread*)(pContext->Owner);
+
+    /* 只有处于阻塞状态的线程才可以被转移 */
+    if (pThread->Status != eThreadBlocked)
+    {
+        uKernelVariable.Diagnosis |= KERNEL_DIAG_THREAD_ERROR;
+        pThread->Diagnosis |= THREAD_DIAG_INVALID_STATE;
+        uDebugPanic("", __FILE__, __FUNCTION__, __LINE__);
+    }
+
+    /* 将线程从原阻塞队列移出 */
+    LeaveBlockedQueue(pContext->Queue, pContext);
+
+    /* 如果线程不再以时限方式等待则关闭该线程的时限定时器 */
+    if ((pContext->Option & IPC_OPT_TIMEO) && (!(option & IPC_OPT_TIMEO)))
+    {
+        uObjListRemoveDiffNode(&(uKernelVariable.ThreadTimerList),
+                               &(pThread->Timer.LinkNode));
+    }
+
+    /* 将线程放入新的阻塞队列 */
+    pContext->Object = pIpc;
+    pContext->Option = option;
+    EnterBlockedQueue(pQueue, pContext);
+}
+
+
 /*************************************************************************************************
  *  功能：选择唤醒阻塞队列中的全部线程                                                           *
  *  参数：(1) pQueue  线程队列结构地址                                                           *
@@ -268,18 +454,59 @@ void uIpcSetPriority(TIpcContext* pContext, TPriority priority)
     {
         if (property & IPC_PROP_PREEMP_AUXIQ)
         {
+#if (TCLC_IPC_QUEUE_O1_ENABLE)
+            RemovePriorityContext(&(pQueue->AuxiliaryHandle), &(pQueue->AuxiliaryMask),
+                                  pQueue->AuxiliaryHeads, pContext);
+            AddPriorityContext(&(pQueue->AuxiliaryHandle), &(pQueue->AuxiliaryMask),
+                               pQueue->AuxiliaryHeads, pContext);
+#else
             uObjQueueRemoveNode(&(pQueue->AuxiliaryHandle), &(pContext->LinkNode));
             uObjQueueAddPriorityNode(&(pQueue->AuxiliaryHandle), &(pContext->LinkNode));
+#endif
         }
     }
     else
     {
         if (property & IPC_PROP_PREEMP_PRIMIQ)
         {
+#if (TCLC_IPC_QUEUE_O1_ENABLE)
+            RemovePriorityContext(&(pQueue->PrimaryHandle), &(pQueue->PrimaryMask),
+                                  pQueue->PrimaryHeads, pContext);
+            AddPriorityContext(&(pQueue->PrimaryHandle), &(pQueue->PrimaryMask),
+                               pQueue->PrimaryHeads, pContext);
+#else
             uObjQueueRemoveNode(&(pQueue->PrimaryHandle), &(pContext->LinkNode));
             uObjQueueAddPriorityNode(&(pQueue->PrimaryHandle), &(pContext->LinkNode));
+#endif
         }
     }
+
+    /* 通知IPC对象线程的优先级已经改变 */
+    if (pContext->Reorder != (TIpcReorder)0)
+    {
+        pContext->Reorder(pContext);
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：初始化IPC线程阻塞队列                                                                  *
+ *  参数：(1) pQueue    线程阻塞队列地址                                                         *
+ *        (2) pProperty 所属IPC对象的属性地址                                                    *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+void uIpcInitQueue(TIpcQueue* pQueue, TProperty* pProperty)
+{
+    pQueue->PrimaryHandle   = (TLinkNode*)0;
+    pQueue->AuxiliaryHandle = (TLinkNode*)0;
+    pQueue->Property        = pProperty;
+#if (TCLC_IPC_QUEUE_O1_ENABLE)
+    pQueue->PrimaryMask     = (TBitMask)0;
+    pQueue->AuxiliaryMask   = (TBitMask)0;
+    memset(pQueue->PrimaryHeads, 0, sizeof(pQueue->PrimaryHeads));
+    memset(pQueue->AuxiliaryHeads, 0, sizeof(pQueue->AuxiliaryHeads));
+#endif
 }
 
 
@@ -311,6 +538,8 @@ void uIpcInitContext(TIpcContext* pContext, void* pIpc, TBase32 data, TBase32 le
     pContext->Option     = option;
     pContext->State      = pState;
     pContext->Error      = pError;
+    pContext->Wakeup     = (TIpcWakeup)0;
+    pContext->Reorder    = (TIpcReorder)0;
 
     pContext->LinkNode.Next   = (TLinkNode*)0;
     pContext->LinkNode.Prev   = (TLinkNode*)0;
@@ -343,6 +572,8 @@ void uIpcCleanContext(TIpcContext* pContext)
     pContext->Option     = IPC_OPT_DEFAULT;
     pContext->State      = (TState*)0;
     pContext->Error      = (TError*)0;
+    pContext->Wakeup     = (TIpcWakeup)0;
+    pContext->Reorder    = (TIpcReorder)0;
 }
 
 #endif
@@ -347,9 +347,7 @@ TState xMailBoxCreate(TMailBox* pMailbox, TChar* pName, TProperty property, TErr
         pMailbox->Status = eMailBoxEmpty;
         pMailbox->Mail = (void*)0;
 
-        pMailbox->Queue.PrimaryHandle   = (TLinkNode*)0;
-        pMailbox->Queue.AuxiliaryHandle = (TLinkNode*)0;
-        pMailbox->Queue.Property        = &(pMailbox->Property);
+        uIpcInitQueue(&(pMailbox->Queue), &(pMailbox->Property));
 
         error = IPC_ERR_NONE;
         state = eSuccess;
@@ -551,4 +549,362 @@ TState xMailBoxBroadcast(TMailBox* pMailbox, TMail* pMail2, TError* pError)
     *pError = error;
     return state;
 }
+
+
+#if (TCLC_IPC_MMBOX_ENABLE)
+/*************************************************************************************************
+ *  功能: 尝试读取多槽邮箱中最早的邮件                                                           *
+ *  参数: (1) pMailbox 邮箱结构地址                                                              *
+ *        (2) pMail2   保存邮件结构地址的指针变量                                                *
+ *        (3) pHiRP    是否在函数中唤醒过其它线程                                                *
+ *        (4) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：邮箱中有邮件时阻塞队列里只可能是写线程，读出邮件后让第一个写线程把它的邮件写入邮箱     *
+ *************************************************************************************************/
+static TState ReceiveMultiMail(TMultiMailBox* pMailbox, void** pMail2, TBool* pHiRP, TError* pError)
+{
+    TState state = eSuccess;
+    TError error = IPC_ERR_NONE;
+    TIpcContext* pContext;
+
+    if (pMailbox->Count > 0U)
+    {
+        *pMail2 = pMailbox->Slots[pMailbox->Head];
+        pMailbox->Head = (pMailbox->Head + 1U) % pMailbox->Depth;
+        pMailbox->Count--;
+
+        if (pMailbox->Property & IPC_PROP_PRIMQ_AVAIL)
+        {
+            pContext = (TIpcContext*)(pMailbox->Queue.PrimaryHandle->Owner);
+            uIpcUnblockThread(pContext, eSuccess, IPC_ERR_NONE, pHiRP);
+
+            pMailbox->Slots[pMailbox->Tail] = *((TMail*)(pContext->Data.Addr2));
+            pMailbox->Tail = (pMailbox->Tail + 1U) % pMailbox->Depth;
+            pMailbox->Count++;
+        }
+    }
+    else
+    {
+        error = IPC_ERR_NORMAL;
+        state = eFailure;
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 尝试向多槽邮箱发送邮件                                                                 *
+ *  参数: (1) pMailbox 邮箱结构地址                                                              *
+ *        (2) pMail2   保存邮件结构地址的指针变量                                                *
+ *        (3) pHiRP    是否在函数中唤醒过其它线程                                                *
+ *        (4) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：覆盖写模式下邮箱满时丢弃最早的邮件，发送总是成功                                       *
+ *************************************************************************************************/
+static TState SendMultiMail(TMultiMailBox* pMailbox, void** pMail2, TBool* pHiRP, TError* pError)
+{
+    TState state = eSuccess;
+    TError error = IPC_ERR_NONE;
+    TIpcContext* pContext;
+
+    /* 邮箱空时阻塞队列里只可能是读线程，把邮件直接交给第一个读线程 */
+    if ((pMailbox->Count == 0U) && (pMailbox->Property & IPC_PROP_PRIMQ_AVAIL))
+    {
+        pContext = (TIpcContext*)(pMailbox->Queue.PrimaryHandle->Owner);
+        uIpcUnblockThread(pContext, eSuccess, IPC_ERR_NONE, pHiRP);
+        *(pContext->Data.Addr2) = *pMail2;
+    }
+    else if (pMailbox->Count < pMailbox->Depth)
+    {
+        pMailbox->Slots[pMailbox->Tail] = *pMail2;
+        pMailbox->Tail = (pMailbox->Tail + 1U) % pMailbox->Depth;
+        pMailbox->Count++;
+    }
+    else if (pMailbox->Property & IPC_PROP_OVERWRITE)
+    {
+        /* 邮箱满时Head和Tail指向同一个槽位，新邮件覆盖最早的邮件 */
+        pMailbox->Slots[pMailbox->Tail] = *pMail2;
+        pMailbox->Tail = (pMailbox->Tail + 1U) % pMailbox->Depth;
+        pMailbox->Head = pMailbox->Tail;
+    }
+    else
+    {
+        error = IPC_ERR_NORMAL;
+        state = eFailure;
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR从多槽邮箱中读取邮件                                                           *
+ *  参数: (1) pMailbox 邮箱结构地址                                                              *
+ *        (2) pMail2   保存邮件结构地址的指针变量                                                *
+ *        (3) option   访问邮箱的模式                                                            *
+ *        (4) timeo    时限阻塞模式下访问邮箱的时限长度                                          *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xMultiMailBoxReceive(TMultiMailBox* pMailbox, TMail* pMail2, TOption option, TTimeTick timeo,
+                            TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TIpcContext context;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+    if (pMailbox->Property &IPC_PROP_READY)
+    {
+        state = ReceiveMultiMail(pMailbox, (void**)pMail2, &HiRP, &error);
+
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U))
+        {
+            /* 如果当前线程解除了更高优先级线程的阻塞则进行调度。*/
+            if (state == eSuccess)
+            {
+                if (HiRP == eTrue)
+                {
+                    uThreadSchedule();
+                }
+            }
+            else
+            {
+                /*
+                * 如果当前线程不能得到邮件,并且采用的是等待方式,并且内核没有关闭线程调度,
+                * 那么当前线程必须阻塞在邮箱队列中,并且强制线程调度
+                */
+                if (option & IPC_OPT_WAIT)
+                {
+                    /* 如果当前线程不能被阻塞则函数直接返回 */
+                    if (uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK)
+                    {
+                        /* 保存线程挂起信息 */
+                        uIpcInitContext(&context, (void*)pMailbox,
+                                        (TBase32)pMail2, sizeof(TBase32),
+                                        option | IPC_OPT_MAILBOX | IPC_OPT_READ_DATA,
+                                        &state, &error);
+
+                        /* 当前线程阻塞在该邮箱的阻塞队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+                        uIpcBlockThread(&context, &(pMailbox->Queue), timeo);
+
+                        /* 当前线程被阻塞，其它线程得以执行 */
+                        uThreadSchedule();
+
+                        CpuLeaveCritical(imask);
+                        /*
+                         * 因为当前线程已经阻塞在邮箱的线程阻塞队列，所以处理器需要执行别的线程。
+                         * 当处理器再次处理本线程时，从本处继续运行。
+                         */
+                        CpuEnterCritical(&imask);
+
+                        /* 清除线程IPC阻塞信息 */
+                        uIpcCleanContext(&context);
+                    }
+                    else
+                    {
+                        error = IPC_ERR_ACAPI;
+                    }
+                }
+            }
+        }
+    }
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR向多槽邮箱中发送邮件                                                           *
+ *  参数: (1) pMailbox 邮箱结构地址                                                              *
+ *        (2) pMail2   保存邮件结构地址的指针变量                                                *
+ *        (3) option   访问邮箱的模式                                                            *
+ *        (4) timeo    时限阻塞模式下访问邮箱的时限长度                                          *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：覆盖写模式的邮箱永远不会阻塞发送线程                                                   *
+ *************************************************************************************************/
+TState xMultiMailBoxSend(TMultiMailBox* pMailbox, TMail* pMail2, TOption option, TTimeTick timeo,
+                         TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TIpcContext context;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+    if (pMailbox->Property &IPC_PROP_READY)
+    {
+        state = SendMultiMail(pMailbox, (void**)pMail2, &HiRP, &error);
+
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U))
+        {
+            /* 如果当前线程解除了更高优先级线程的阻塞则进行调度。*/
+            if (state == eSuccess)
+            {
+                if (HiRP == eTrue)
+                {
+                    uThreadSchedule();
+                }
+            }
+            else
+            {
+                /*
+                * 如果当前线程不能发送邮件,并且采用的是等待方式,并且内核没有关闭线程调度,
+                * 那么当前线程必须阻塞在邮箱队列中,并且强制线程调度
+                */
+                if (option & IPC_OPT_WAIT)
+                {
+                    /* 如果当前线程不能被阻塞则函数直接返回 */
+                    if (uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK)
+                    {
+                        /* 保存线程挂起信息 */
+                        uIpcInitContext(&context, (void*)pMailbox,
+                                        (TBase32)pMail2, sizeof(TBase32),
+                                        option | IPC_OPT_MAILBOX | IPC_OPT_WRITE_DATA,
+                                        &state, &error);
+
+                        /* 当前线程阻塞在该邮箱的阻塞队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+                        uIpcBlockThread(&context, &(pMailbox->Queue), timeo);
+
+                        /* 当前线程被阻塞，其它线程得以执行 */
+                        uThreadSchedule();
+
+                        CpuLeaveCritical(imask);
+                        /*
+                         * 因为当前线程已经阻塞在邮箱的线程阻塞队列，所以处理器需要执行别的线程。
+                         * 当处理器再次处理本线程时，从本处继续运行。
+                         */
+                        CpuEnterCritical(&imask);
+
+                        /* 清除线程IPC阻塞信息 */
+                        uIpcCleanContext(&context);
+                    }
+                    else
+                    {
+                        error = IPC_ERR_ACAPI;
+                    }
+                }
+            }
+        }
+    }
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：初始化多槽邮箱                                                                         *
+ *  参数：(1) pMailbox   邮箱的地址                                                              *
+ *        (2) pName      邮箱的名称                                                              *
+ *        (3) pSlots     邮件槽位数组地址                                                        *
+ *        (4) depth      邮件槽位数目                                                            *
+ *        (5) property   邮箱的初始属性，IPC_PROP_OVERWRITE表示覆盖写模式                        *
+ *        (6) pError     详细调用结果                                                            *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xMultiMailBoxCreate(TMultiMailBox* pMailbox, TChar* pName, TMail* pSlots, TBase32 depth,
+                           TProperty property, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_FAULT;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (!(pMailbox->Property &IPC_PROP_READY))
+    {
+        /* 初始化邮箱对象信息 */
+        uKernelAddObject(&(pMailbox->Object), pName, eMultiMailbox, (void*)pMailbox);
+
+        /* 初始化邮箱基本信息 */
+        property |= IPC_PROP_READY;
+        pMailbox->Property = property;
+        pMailbox->Slots = pSlots;
+        pMailbox->Depth = depth;
+        pMailbox->Count = 0U;
+        pMailbox->Head = 0U;
+        pMailbox->Tail = 0U;
+
+        uIpcInitQueue(&(pMailbox->Queue), &(pMailbox->Property));
+
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：删除多槽邮箱                                                                           *
+ *  参数：(1) pMailbox   邮箱的地址                                                              *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：注意线程的等待结果都是IPC_ERR_DELETE                                                   *
+ *************************************************************************************************/
+TState xMultiMailBoxDelete(TMultiMailBox* pMailbox, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TReg32 imask;
+    TBool HiRP = eFalse;
+
+    CpuEnterCritical(&imask);
+
+    if (pMailbox->Property &IPC_PROP_READY)
+    {
+        /* 将邮箱阻塞队列上的所有等待线程都释放,所有线程的等待结果都是IPC_ERR_DELETE  */
+        uIpcUnblockAll(&(pMailbox->Queue), eFailure, IPC_ERR_DELETE, (void**)0, &HiRP);
+
+        /* 从内核中移除邮箱对象 */
+        uKernelRemoveObject(&(pMailbox->Object));
+
+        /* 清除邮箱对象的全部数据 */
+        memset(pMailbox, 0U, sizeof(TMultiMailBox));
+
+        /*
+         * 在线程环境下，如果当前线程的优先级已经不再是线程就绪队列的最高优先级，
+         * 并且内核此时并没有关闭线程调度，那么就需要进行一次线程抢占
+         */
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+#endif
+
 #endif
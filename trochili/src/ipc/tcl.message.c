@@ -314,6 +314,135 @@ extern TState xMQReceive(TMsgQueue* pMsgQue, TMessage* pMsg2, TOption option,
 }
 
 
+#if ((TCLC_IPC_MQUE_LOAN_ENABLE)&&(TCLC_MEMORY_ENABLE)&&(TCLC_MEMORY_POOL_ENABLE))
+/*************************************************************************************************
+ *  功能：检查缓冲区是否是从消息队列借出的缓冲区
+ *  参数：(1) pMsgQue 消息队列结构指针
+ *        (2) pBuf    缓冲区地址
+ *  返回：(1) eTrue   是借出的缓冲区
+ *        (2) eFalse  不是借出的缓冲区
+ *  说明：缓冲区必须是绑定的内存池中已被分配的内存页(检查规则和xPoolMemFree相同)，
+ *        并且被标记为借出，用户自己从同一个内存池申请的内存页不算借出的缓冲区
+ *************************************************************************************************/
+static TBool IsLoanBuffer(TMsgQueue* pMsgQue, void* pBuf)
+{
+    TIndex index;
+
+    if (uPoolMemCheck(pMsgQue->BufferPool, pBuf) == eFalse)
+    {
+        return eFalse;
+    }
+
+    index = ((TChar*)pBuf - pMsgQue->BufferPool->PageAddr) / (pMsgQue->BufferPool->PageSize);
+    if (pMsgQue->LoanTags[index >> 5] & (0x1U << (index & 0x1f)))
+    {
+        return eTrue;
+    }
+    return eFalse;
+}
+
+
+/*************************************************************************************************
+ *  功能：设置或者清除缓冲区的借出标记
+ *  参数：(1) pMsgQue 消息队列结构指针
+ *        (2) pBuf    缓冲区地址，必须是绑定的内存池中的内存页
+ *        (3) loaned  是否借出
+ *  返回：无
+ *  说明：
+ *************************************************************************************************/
+static void MarkLoanBuffer(TMsgQueue* pMsgQue, void* pBuf, TBool loaned)
+{
+    TIndex index;
+
+    index = ((TChar*)pBuf - pMsgQue->BufferPool->PageAddr) / (pMsgQue->BufferPool->PageSize);
+    if (loaned == eTrue)
+    {
+        pMsgQue->LoanTags[index >> 5] |= (0x1U << (index & 0x1f));
+    }
+    else
+    {
+        pMsgQue->LoanTags[index >> 5] &= ~(0x1U << (index & 0x1f));
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：把借出的缓冲区交给等待缓冲区的线程或者归还到内存池
+ *  参数：(1) pMsgQue 消息队列结构指针
+ *        (2) pBuf    缓冲区地址
+ *        (3) pHiRP   是否需要线程调度标记
+ *        (4) pError  详细调用结果
+ *  返回：(1) eSuccess 操作成功
+ *        (2) eFailure 操作失败
+ *  说明：(1) 不是从本消息队列借出的缓冲区被拒绝
+ *        (2) 交给等待线程的缓冲区仍然处于借出状态，归还到内存池的缓冲区清除借出标记
+ *        (3) 这个函数不能处理线程调度
+ *************************************************************************************************/
+static TState ReturnBuffer(TMsgQueue* pMsgQue, void* pBuf, TBool* pHiRP, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_FAULT;
+    TError memError;
+    TIpcContext* pContext;
+
+    if (IsLoanBuffer(pMsgQue, pBuf) == eTrue)
+    {
+        if (pMsgQue->LoanProperty & IPC_PROP_PRIMQ_AVAIL)
+        {
+            /* 和内存池分配的内存页一样，交出的缓冲区内容被清空 */
+            memset(pBuf, 0U, pMsgQue->BufferPool->PageSize);
+
+            pContext = (TIpcContext*)(pMsgQue->LoanQueue.PrimaryHandle->Owner);
+            uIpcUnblockThread(pContext, eSuccess, IPC_ERR_NONE, pHiRP);
+            *(pContext->Data.Addr2) = pBuf;
+
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            MarkLoanBuffer(pMsgQue, pBuf, eFalse);
+            state = xPoolMemFree(pMsgQue->BufferPool, pBuf, &memError);
+            error = (state == eSuccess) ? IPC_ERR_NONE : IPC_ERR_FAULT;
+        }
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：回收消息队列中尚未被读取的借出缓冲区
+ *  参数：(1) pMsgQue 消息队列结构指针
+ *        (2) pHiRP   是否需要线程调度标记
+ *  返回：无
+ *  说明：(1) 消息队列被删除或者重置时，已提交但未被接收的缓冲区没有线程再会归还，在这里回收
+ *        (2) 普通消息即使指向同一个内存池中的内存页也不会被回收
+ *************************************************************************************************/
+static void ReclaimBuffers(TMsgQueue* pMsgQue, TBool* pHiRP)
+{
+    TBase32 index;
+    TBase32 count;
+    TError error;
+
+    if (pMsgQue->BufferPool != (TMemPool*)0)
+    {
+        index = pMsgQue->Tail;
+        for (count = 0U; count < pMsgQue->MsgEntries; count++)
+        {
+            ReturnBuffer(pMsgQue, *(pMsgQue->MsgPool + index), pHiRP, &error);
+            index++;
+            if (index == pMsgQue->Capacity)
+            {
+                index = 0U;
+            }
+        }
+    }
+}
+#endif
+
+
 /*************************************************************************************************
  *  功能: 用于线程/ISR向消息队列中发送消息                                                       *
  *  参数: (1) pMsgQue  消息队列结构地址                                                          *
@@ -410,6 +539,241 @@ TState xMQSend(TMsgQueue* pMsgQue, TMessage* pMsg2, TOption option, TTimeTick ti
 }
 
 
+/*************************************************************************************************
+ *  功能: 用于线程/ISR批量接收消息队列中的消息                                                   *
+ *  参数: (1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pMsgs    保存消息的数组地址                                                        *
+ *        (3) number   最多接收的消息数目                                                        *
+ *        (4) pCount   实际接收的消息数目                                                        *
+ *        (5) option   访问消息队列的模式                                                        *
+ *        (6) timeo    时限阻塞模式下访问消息队列的时限长度                                      *
+ *        (7) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：在一个临界区内连续读取消息，每读出一个消息最多唤醒一个写线程，全部完成后最多调度一次;  *
+ *        只有一个消息也读不到时线程才会阻塞，被唤醒后继续读取队列中剩余的消息                   *
+ *************************************************************************************************/
+TState xMQReceiveBatch(TMsgQueue* pMsgQue, TMessage* pMsgs, TBase32 number, TBase32* pCount,
+                       TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBase32 count = 0U;
+    TBool  HiRP = eFalse;
+    TIpcContext context;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pMsgQue->Property & IPC_PROP_READY)
+    {
+        while (count < number)
+        {
+            state = ReceiveMessage(pMsgQue, (void**)(pMsgs + count), &HiRP, &error);
+            if (state == eFailure)
+            {
+                break;
+            }
+            count++;
+        }
+
+        /*
+         * 如果当前线程一个消息也不能接收，并且采用的是等待方式，
+         * 那么当前线程必须阻塞在消息队列中
+         */
+        if ((count == 0U) &&
+                (uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (option & IPC_OPT_WAIT))
+        {
+            /* 如果当前线程不能被阻塞则函数直接返回 */
+            if (uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK)
+            {
+                /* 保存线程挂起信息 */
+                option |= IPC_OPT_MSGQUEUE | IPC_OPT_READ_DATA;
+                uIpcInitContext(&context, (void*)pMsgQue, (TBase32)pMsgs, sizeof(TBase32), option,
+                                &state, &error);
+
+                /* 当前线程阻塞在该消息队列的阻塞队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+                uIpcBlockThread(&context, &(pMsgQue->Queue), timeo);
+
+                /* 当前线程被阻塞，其它线程得以执行 */
+                uThreadSchedule();
+
+                CpuLeaveCritical(imask);
+                /*
+                 * 因为当前线程已经阻塞在IPC对象的线程阻塞队列，所以处理器需要执行别的线程。
+                 * 当处理器再次处理本线程时，从本处继续运行。
+                 */
+                CpuEnterCritical(&imask);
+
+                /* 清除线程挂起信息 */
+                uIpcCleanContext(&context);
+
+                /* 被唤醒时已经得到一个消息，继续以非阻塞方式读取队列中剩余的消息 */
+                if (state == eSuccess)
+                {
+                    count = 1U;
+                    HiRP = eFalse;
+                    while (count < number)
+                    {
+                        if (ReceiveMessage(pMsgQue, (void**)(pMsgs + count), &HiRP, &error) == eFailure)
+                        {
+                            break;
+                        }
+                        count++;
+                    }
+                }
+            }
+            else
+            {
+                error = IPC_ERR_ACAPI;
+            }
+        }
+
+        if (count != 0U)
+        {
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+
+            /* 如果当前线程解除了更高优先级线程的阻塞则进行调度。*/
+            if ((uKernelVariable.State == eThreadState) &&
+                    (uKernelVariable.SchedLockTimes == 0U) &&
+                    (HiRP == eTrue))
+            {
+                uThreadSchedule();
+            }
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pCount = count;
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 用于线程/ISR向消息队列中批量发送消息                                                   *
+ *  参数: (1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pMsgs    待发送的消息数组地址                                                      *
+ *        (3) number   待发送的消息数目                                                          *
+ *        (4) pCount   实际发送的消息数目                                                        *
+ *        (5) option   访问消息队列的模式                                                        *
+ *        (6) timeo    时限阻塞模式下访问消息队列的时限长度                                      *
+ *        (7) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：在一个临界区内连续发送消息，每个消息最多唤醒一个读线程，全部完成后最多调度一次;        *
+ *        紧急消息逐个放到队列头，最后发送的消息最先被读取，和逐个调用xMQSend的结果相同          *
+ *************************************************************************************************/
+TState xMQSendBatch(TMsgQueue* pMsgQue, TMessage* pMsgs, TBase32 number, TBase32* pCount,
+                    TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBase32 count = 0U;
+    TBool HiRP = eFalse;
+    TIpcContext context;
+    TMsgType type;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+    if (pMsgQue->Property & IPC_PROP_READY)
+    {
+        type = (option & IPC_OPT_UARGENT) ? eUrgentMessage : eNormalMessage;
+        while (count < number)
+        {
+            state = SendMessage(pMsgQue, (void**)(pMsgs + count), type, &HiRP, &error);
+            if (state == eFailure)
+            {
+                break;
+            }
+            count++;
+        }
+
+        /*
+         * 如果当前线程一个消息也不能发送，并且采用的是等待方式，
+         * 那么当前线程必须阻塞在消息队列中
+         */
+        if ((count == 0U) &&
+                (uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (option & IPC_OPT_WAIT))
+        {
+            /* 如果当前线程不能被阻塞则函数直接返回 */
+            if (uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK)
+            {
+                if (option & IPC_OPT_UARGENT)
+                {
+                    option |= IPC_OPT_USE_AUXIQ;
+                }
+
+                /* 保存线程挂起信息 */
+                option |= IPC_OPT_MSGQUEUE | IPC_OPT_WRITE_DATA;
+                uIpcInitContext(&context, (void*)pMsgQue, (TBase32)pMsgs, sizeof(TBase32), option,
+                                &state, &error);
+
+                /* 当前线程阻塞在该消息队列的阻塞队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+                uIpcBlockThread(&context, &(pMsgQue->Queue), timeo);
+
+                /* 当前线程被阻塞，其它线程得以执行 */
+                uThreadSchedule();
+
+                CpuLeaveCritical(imask);
+                /*
+                 * 因为当前线程已经阻塞在IPC对象的线程阻塞队列，所以处理器需要执行别的线程。
+                 * 当处理器再次处理本线程时，从本处继续运行。
+                 */
+                CpuEnterCritical(&imask);
+
+                /* 清除线程挂起信息 */
+                uIpcCleanContext(&context);
+
+                /* 被唤醒时第一个消息已经被接收，继续以非阻塞方式发送剩余的消息 */
+                if (state == eSuccess)
+                {
+                    count = 1U;
+                    HiRP = eFalse;
+                    while (count < number)
+                    {
+                        if (SendMessage(pMsgQue, (void**)(pMsgs + count), type, &HiRP, &error) == eFailure)
+                        {
+                            break;
+                        }
+                        count++;
+                    }
+                }
+            }
+            else
+            {
+                error = IPC_ERR_ACAPI;
+            }
+        }
+
+        if (count != 0U)
+        {
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+
+            /* 如果当前线程解除了更高优先级线程的阻塞则进行调度。*/
+            if ((uKernelVariable.State == eThreadState) &&
+                    (uKernelVariable.SchedLockTimes == 0U) &&
+                    (HiRP == eTrue))
+            {
+                uThreadSchedule();
+            }
+        }
+    }
+    CpuLeaveCritical(imask);
+
+    *pCount = count;
+    *pError = error;
+    return state;
+}
+
+
 /*************************************************************************************************
  *  功能：消息队列初始化函数                                                                     *
  *  输入：(1) pMsgQue   消息队列结构地址                                                         *
@@ -446,9 +810,15 @@ TState xMQCreate(TMsgQueue* pMsgQue, TChar* pName, void** pPool2, TBase32 capaci
         pMsgQue->Tail = 0U;
         pMsgQue->Status = eMQEmpty;
 
-        pMsgQue->Queue.PrimaryHandle   = (TLinkNode*)0;
-        pMsgQue->Queue.AuxiliaryHandle = (TLinkNode*)0;
-        pMsgQue->Queue.Property        = &(pMsgQue->Property);
+        uIpcInitQueue(&(pMsgQue->Queue), &(pMsgQue->Property));
+
+#if ((TCLC_IPC_MQUE_LOAN_ENABLE)&&(TCLC_MEMORY_ENABLE)&&(TCLC_MEMORY_POOL_ENABLE))
+        /* 等待缓冲区的线程和消息队列采用相同的调度策略 */
+        pMsgQue->BufferPool = (TMemPool*)0;
+        memset(pMsgQue->LoanTags, 0U, sizeof(pMsgQue->LoanTags));
+        pMsgQue->LoanProperty = IPC_PROP_READY | (property & IPC_PROP_PREEMP_PRIMIQ);
+        uIpcInitQueue(&(pMsgQue->LoanQueue), &(pMsgQue->LoanProperty));
+#endif
 
         error = IPC_ERR_NONE;
         state = eSuccess;
@@ -467,7 +837,7 @@ TState xMQCreate(TMsgQueue* pMsgQue, TChar* pName, void** pPool2, TBase32 capaci
  *        (2) pError    详细调用结果                                                             *
  *  返回：(1) eSuccess  操作成功                                                                 *
  *        (2) eFailure  操作失败                                                                 *
- *  说明：                                                                                       *
+ *  说明：已提交但未被接收的借出缓冲区归还到内存池，线程手中的借出缓冲区需要用xPoolMemFree归还
  *************************************************************************************************/
 TState xMQDelete(TMsgQueue* pMsgQue, TError* pError)
 {
@@ -482,6 +852,14 @@ TState xMQDelete(TMsgQueue* pMsgQue, TError* pError)
     {
         /* 向阻塞队列中的线程分发消息 */
         uIpcUnblockAll(&(pMsgQue->Queue), eFailure, IPC_ERR_DELETE, (void**)0, &HiRP);
+#if ((TCLC_IPC_MQUE_LOAN_ENABLE)&&(TCLC_MEMORY_ENABLE)&&(TCLC_MEMORY_POOL_ENABLE))
+        uIpcUnblockAll(&(pMsgQue->LoanQueue), eFailure, IPC_ERR_DELETE, (void**)0, &HiRP);
+#endif
+
+#if ((TCLC_IPC_MQUE_LOAN_ENABLE)&&(TCLC_MEMORY_ENABLE)&&(TCLC_MEMORY_POOL_ENABLE))
+        /* 回收队列中尚未被读取的借出缓冲区 */
+        ReclaimBuffers(pMsgQue, &HiRP);
+#endif
 
     	/* 从内核中移除消息队列对象 */
         uKernelRemoveObject(&(pMsgQue->Object));
@@ -532,6 +910,11 @@ TState xMQReset(TMsgQueue* pMsgQue, TError* pError)
         /* 将阻塞队列上的所有等待线程都释放，所有线程的等待结果都是TCLE_IPC_RESET    */
         uIpcUnblockAll(&(pMsgQue->Queue), eFailure, IPC_ERR_RESET, (void**)0, &HiRP);
 
+#if ((TCLC_IPC_MQUE_LOAN_ENABLE)&&(TCLC_MEMORY_ENABLE)&&(TCLC_MEMORY_POOL_ENABLE))
+        /* 被丢弃的借出缓冲区交给等待缓冲区的线程或者归还到内存池 */
+        ReclaimBuffers(pMsgQue, &HiRP);
+#endif
+
         /* 重新设置消息队列结构 */
         pMsgQue->Property &= IPC_RESET_MQUE_PROP;
         pMsgQue->MsgEntries = 0U;
@@ -583,6 +966,9 @@ TState xMQFlush(TMsgQueue* pMsgQue, TError* pError)
     {
         /* 将消息队列阻塞队列上的所有等待线程都释放，所有线程的等待结果都是TCLE_IPC_FLUSH  */
         uIpcUnblockAll(&(pMsgQue->Queue), eFailure, IPC_ERR_FLUSH, (void**)0, &HiRP);
+#if ((TCLC_IPC_MQUE_LOAN_ENABLE)&&(TCLC_MEMORY_ENABLE)&&(TCLC_MEMORY_POOL_ENABLE))
+        uIpcUnblockAll(&(pMsgQue->LoanQueue), eFailure, IPC_ERR_FLUSH, (void**)0, &HiRP);
+#endif
 
         /*
          * 在线程环境下，如果当前线程的优先级已经不再是线程就绪队列的最高优先级，
@@ -657,5 +1043,201 @@ TState xMQBroadcast(TMsgQueue* pMsgQue, TMessage* pMsg2, TError* pError)
 }
 
 
+#if ((TCLC_IPC_MQUE_LOAN_ENABLE)&&(TCLC_MEMORY_ENABLE)&&(TCLC_MEMORY_POOL_ENABLE))
+/*************************************************************************************************
+ *  功能：为消息队列绑定借出缓冲区的内存池                                                       *
+ *  参数：(1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pPool    内存池结构地址                                                            *
+ *        (3) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：每个消息队列只能绑定一次                                                               *
+ *************************************************************************************************/
+TState xMQBindPool(TMsgQueue* pMsgQue, TMemPool* pPool, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pMsgQue->Property & IPC_PROP_READY)
+    {
+        if (pMsgQue->BufferPool == (TMemPool*)0)
+        {
+            pMsgQue->BufferPool = pPool;
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = IPC_ERR_FAULT;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：从消息队列绑定的内存池中借出一个消息缓冲区                                             *
+ *  参数：(1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pBuf2    保存缓冲区地址的指针变量                                                  *
+ *        (3) option   访问内存池的模式                                                          *
+ *        (4) timeo    时限阻塞模式下等待缓冲区的时限长度                                        *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：内存池耗尽时，以等待方式调用的线程阻塞直到有缓冲区被归还                               *
+ *************************************************************************************************/
+TState xMQLoanBuffer(TMsgQueue* pMsgQue, void** pBuf2, TOption option, TTimeTick timeo,
+                     TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TError memError;
+    TIpcContext context;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if ((pMsgQue->Property & IPC_PROP_READY) && (pMsgQue->BufferPool != (TMemPool*)0))
+    {
+        state = xPoolMemMalloc(pMsgQue->BufferPool, pBuf2, &memError);
+        if (state == eSuccess)
+        {
+            MarkLoanBuffer(pMsgQue, *pBuf2, eTrue);
+            error = IPC_ERR_NONE;
+        }
+        else
+        {
+            error = IPC_ERR_NORMAL;
+
+            if ((uKernelVariable.State == eThreadState) &&
+                    (uKernelVariable.SchedLockTimes == 0U) &&
+                    (option & IPC_OPT_WAIT))
+            {
+                /* 如果当前线程不能被阻塞则函数直接返回 */
+                if (uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK)
+                {
+                    /* 保存线程挂起信息 */
+                    option |= IPC_OPT_MSGQUEUE | IPC_OPT_READ_DATA;
+                    uIpcInitContext(&context, (void*)pMsgQue, (TBase32)pBuf2, sizeof(TBase32), option,
+                                    &state, &error);
+
+                    /* 当前线程阻塞在缓冲区等待队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+                    uIpcBlockThread(&context, &(pMsgQue->LoanQueue), timeo);
+
+                    /* 当前线程被阻塞，其它线程得以执行 */
+                    uThreadSchedule();
+
+                    CpuLeaveCritical(imask);
+                    /*
+                     * 因为当前线程已经阻塞在IPC对象的线程阻塞队列，所以处理器需要执行别的线程。
+                     * 当处理器再次处理本线程时，从本处继续运行。
+                     */
+                    CpuEnterCritical(&imask);
+
+                    /* 清除线程挂起信息 */
+                    uIpcCleanContext(&context);
+                }
+                else
+                {
+                    error = IPC_ERR_ACAPI;
+                }
+            }
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：把借出的缓冲区作为消息提交到消息队列                                                   *
+ *  参数：(1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pBuf     借出的缓冲区地址                                                          *
+ *        (3) option   访问消息队列的模式                                                        *
+ *        (4) timeo    时限阻塞模式下访问消息队列的时限长度                                      *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：(1) 提交成功后缓冲区的所有权转移给接收线程，失败时仍由发送线程持有
+ *        (2) 不是从本消息队列借出的缓冲区被拒绝
+ *************************************************************************************************/
+TState xMQCommitBuffer(TMsgQueue* pMsgQue, void* pBuf, TOption option, TTimeTick timeo,
+                       TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if ((pMsgQue->Property & IPC_PROP_READY) && (pMsgQue->BufferPool != (TMemPool*)0))
+    {
+        error = IPC_ERR_FAULT;
+        if (IsLoanBuffer(pMsgQue, pBuf) == eTrue)
+        {
+            error = IPC_ERR_NONE;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    /* 发送可能阻塞，必须在临界区之外进行 */
+    if (error == IPC_ERR_NONE)
+    {
+        state = xMQSend(pMsgQue, (TMessage*)(&pBuf), option, timeo, &error);
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：接收线程归还用完的缓冲区                                                               *
+ *  参数：(1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pBuf     缓冲区地址                                                                *
+ *        (3) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：(1) 如果有线程在等待缓冲区，缓冲区被直接交给第一个等待线程
+ *        (2) 不是从本消息队列借出的缓冲区被拒绝
+ *        (3) 消息队列删除后，线程手中的借出缓冲区需要用xPoolMemFree直接归还到内存池
+ *************************************************************************************************/
+TState xMQReturnBuffer(TMsgQueue* pMsgQue, void* pBuf, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if ((pMsgQue->Property & IPC_PROP_READY) && (pMsgQue->BufferPool != (TMemPool*)0))
+    {
+        state = ReturnBuffer(pMsgQue, pBuf, &HiRP, &error);
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
 #endif
 
+#endif
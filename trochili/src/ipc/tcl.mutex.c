@@ -90,8 +90,8 @@ static TState RemoveLock(TThread* pThread, TMutex* pMutex, TBool* pHiRP, TError*
             /* 如果线程没有占有别的互斥量上,则设置线程优先级可以被API修改 */
             pThread->Property |= (THREAD_PROP_PRIORITY_SAFE);
 
-            /* 准备恢复线程优先级 */
-            priority = pThread->BasePriority;
+            /* 准备恢复线程优先级，CPU预算耗尽的线程恢复到后台优先级 */
+            priority = uThreadGetBasePriority(pThread);
             nflag = eTrue;
         }
         else
@@ -214,6 +214,59 @@ static TState FreeMutex(TMutex* pMutex, TBool* pHiRP, TError* pError)
     return state;
 }
 
+#if (TCLC_IPC_CONDVAR_ENABLE)
+/*************************************************************************************************
+ *  功能: 当前线程彻底释放互斥量，供条件变量使用                                                 *
+ *  参数: (1) pMutex   互斥量结构地址                                                            *
+ *        (2) pNest    保存互斥量嵌套加锁深度                                                    *
+ *        (3) pHiRP    是否有更高优先级就绪                                                      *
+ *        (4) pError   详细调用结果                                                              *
+ *  返回: (1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：不管嵌套加锁多少次都一次释放，线程重新获得互斥量后再恢复嵌套深度                       *
+ *************************************************************************************************/
+TState uMutexRelease(TMutex* pMutex, TBase32* pNest, TBool* pHiRP, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_NORMAL;
+
+    if (pMutex->Owner == uKernelVariable.CurrentThread)
+    {
+        *pNest = pMutex->Nest;
+        pMutex->Nest = 1U;
+        state = FreeMutex(pMutex, pHiRP, &error);
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 把空闲的互斥量直接交给指定线程，供条件变量使用                                         *
+ *  参数: (1) pMutex   互斥量结构地址                                                            *
+ *        (2) pThread  线程结构地址                                                              *
+ *        (3) pHiRP    是否有更高优先级就绪                                                      *
+ *        (4) pError   详细调用结果                                                              *
+ *  返回: (1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：线程获得互斥量时同样实施优先级天花板算法                                               *
+ *************************************************************************************************/
+TState uMutexGrant(TMutex* pMutex, TThread* pThread, TBool* pHiRP, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_NORMAL;
+
+    if (pMutex->Owner == (TThread*)0)
+    {
+        state = AddLock(pThread, pMutex, pHiRP, &error);
+    }
+
+    *pError = error;
+    return state;
+}
+#endif
+
 /*
  * 互斥量操纵不允许在ISR中被调用
  */
@@ -386,9 +439,7 @@ TState xMutexCreate(TMutex* pMutex, TChar* pName, TPriority priority, TProperty
         pMutex->Owner = (TThread*)0;
         pMutex->Priority = priority;
 
-        pMutex->Queue.PrimaryHandle   = (TLinkNode*)0;
-        pMutex->Queue.AuxiliaryHandle = (TLinkNode*)0;
-        pMutex->Queue.Property        = &(pMutex->Property);
+        uIpcInitQueue(&(pMutex->Queue), &(pMutex->Property));
 
         pMutex->LockNode.Owner = (void*)pMutex;
         pMutex->LockNode.Data = (TBase32*)(&(pMutex->Priority));
@@ -0,0 +1,442 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#include <string.h>
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.cpu.h"
+#include "tcl.debug.h"
+#include "tcl.thread.h"
+#include "tcl.kernel.h"
+#include "tcl.ipc.h"
+#include "tcl.message.h"
+#include "tcl.prioqueue.h"
+
+#if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_MQUE_ENABLE)&&(TCLC_IPC_PMQUE_ENABLE))
+
+/*************************************************************************************************
+ *  功能：将消息保存到对应优先级的消息链表尾部                                                   *
+ *  参数：(1) pMsgQue  消息队列结构指针                                                          *
+ *        (2) pMsg2    保存消息结构地址的指针变量                                                *
+ *        (3) priority 消息优先级                                                                *
+ *  返回：无                                                                                     *
+ *  说明：调用者保证消息队列不满                                                                 *
+ *************************************************************************************************/
+static void SavePrioMessage(TPrioMsgQueue* pMsgQue, void** pMsg2, TPriority priority)
+{
+    TPrioMsgNode* pNode;
+
+    /* 从空闲链表中取出一个节点 */
+    pNode = pMsgQue->FreeList;
+    pMsgQue->FreeList = pNode->Next;
+
+    pNode->Message = *pMsg2;
+    pNode->Next = (TPrioMsgNode*)0;
+
+    /* 同一优先级的消息先进先出 */
+    if (pMsgQue->Heads[priority] == (TPrioMsgNode*)0)
+    {
+        pMsgQue->Heads[priority] = pNode;
+        pMsgQue->PrioMask |= ((TBitMask)0x1 << priority);
+    }
+    else
+    {
+        pMsgQue->Tails[priority]->Next = pNode;
+    }
+    pMsgQue->Tails[priority] = pNode;
+
+    pMsgQue->MsgEntries++;
+}
+
+
+/*************************************************************************************************
+ *  功能：从最高优先级的消息链表中读出消息                                                       *
+ *  参数：(1) pMsgQue  消息队列结构指针                                                          *
+ *        (2) pMsg2    保存消息结构地址的指针变量                                                *
+ *  返回：无                                                                                     *
+ *  说明：调用者保证消息队列不空                                                                 *
+ *************************************************************************************************/
+static void ConsumePrioMessage(TPrioMsgQueue* pMsgQue, void** pMsg2)
+{
+    TPrioMsgNode* pNode;
+    TPriority priority;
+
+    /* 数值越小优先级越高 */
+    priority = CpuCalcHiPRIO(pMsgQue->PrioMask);
+    pNode = pMsgQue->Heads[priority];
+    pMsgQue->Heads[priority] = pNode->Next;
+    if (pNode->Next == (TPrioMsgNode*)0)
+    {
+        pMsgQue->Tails[priority] = (TPrioMsgNode*)0;
+        pMsgQue->PrioMask &= ~((TBitMask)0x1 << priority);
+    }
+
+    *pMsg2 = pNode->Message;
+
+    /* 将节点归还到空闲链表 */
+    pNode->Next = pMsgQue->FreeList;
+    pMsgQue->FreeList = pNode;
+
+    pMsgQue->MsgEntries--;
+}
+
+
+/*************************************************************************************************
+ *  功能：线程/ISR尝试从消息队列中读取消息                                                       *
+ *  参数：(1) pMsgQue 消息队列的地址                                                             *
+ *        (2) pMsg2   保存消息结构地址的指针变量                                                 *
+ *        (3) pHiRP   是否需要线程调度标记                                                       *
+ *        (4) pError  详细调用结果                                                               *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：消息队列满时阻塞队列里是写线程，读出消息后让第一个写线程把它的消息写入队列             *
+ *************************************************************************************************/
+static TState ReceivePrioMessage(TPrioMsgQueue* pMsgQue, void** pMsg2, TBool* pHiRP, TError* pError)
+{
+    TState state = eSuccess;
+    TError error = IPC_ERR_NONE;
+    TIpcContext* pContext;
+
+    if (pMsgQue->MsgEntries == 0U)
+    {
+        error = IPC_ERR_NORMAL;
+        state = eFailure;
+    }
+    else
+    {
+        ConsumePrioMessage(pMsgQue, pMsg2);
+
+        if ((pMsgQue->MsgEntries + 1U == pMsgQue->Capacity) &&
+                (pMsgQue->Property & IPC_PROP_PRIMQ_AVAIL))
+        {
+            pContext = (TIpcContext*)(pMsgQue->Queue.PrimaryHandle->Owner);
+            uIpcUnblockThread(pContext, eSuccess, IPC_ERR_NONE, pHiRP);
+
+            /* 写线程的消息优先级保存在Length中 */
+            SavePrioMessage(pMsgQue, pContext->Data.Addr2, (TPriority)(pContext->Length));
+        }
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：线程/ISR尝试向消息队列中发送消息                                                       *
+ *  参数：(1) pMsgQue  消息队列的地址                                                            *
+ *        (2) pMsg2    保存消息结构地址的指针变量                                                *
+ *        (3) priority 消息优先级                                                                *
+ *        (4) pHiRP    是否需要线程调度标记                                                      *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：消息队列空时阻塞队列里是读线程，消息直接交给第一个读线程                               *
+ *************************************************************************************************/
+static TState SendPrioMessage(TPrioMsgQueue* pMsgQue, void** pMsg2, TPriority priority,
+                              TBool* pHiRP, TError* pError)
+{
+    TState state = eSuccess;
+    TError error = IPC_ERR_NONE;
+    TIpcContext* pContext;
+
+    if (pMsgQue->MsgEntries == pMsgQue->Capacity)
+    {
+        error = IPC_ERR_NORMAL;
+        state = eFailure;
+    }
+    else if ((pMsgQue->MsgEntries == 0U) && (pMsgQue->Property & IPC_PROP_PRIMQ_AVAIL))
+    {
+        pContext = (TIpcContext*)(pMsgQue->Queue.PrimaryHandle->Owner);
+        uIpcUnblockThread(pContext, eSuccess, IPC_ERR_NONE, pHiRP);
+        *(pContext->Data.Addr2) = *pMsg2;
+    }
+    else
+    {
+        SavePrioMessage(pMsgQue, pMsg2, priority);
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 用于线程/ISR接收消息队列中优先级最高的消息                                             *
+ *  参数: (1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pMsg2    保存消息结构地址的指针变量                                                *
+ *        (3) option   访问消息队列的模式                                                        *
+ *        (4) timeo    时限阻塞模式下访问消息队列的时限长度                                      *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xPMQReceive(TPrioMsgQueue* pMsgQue, TMessage* pMsg2, TOption option, TTimeTick timeo,
+                   TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool  HiRP = eFalse;
+    TIpcContext context;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pMsgQue->Property & IPC_PROP_READY)
+    {
+        state = ReceivePrioMessage(pMsgQue, (void**)pMsg2, &HiRP, &error);
+
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U))
+        {
+            /* 如果当前线程解除了更高优先级线程的阻塞则进行调度。*/
+            if (state == eSuccess)
+            {
+                if (HiRP == eTrue)
+                {
+                    uThreadSchedule();
+                }
+            }
+            else
+            {
+                /*
+                 * 如果当前线程不能接收消息，并且采用的是等待方式，
+                 * 那么当前线程必须阻塞在消息队列中
+                 */
+                if (option & IPC_OPT_WAIT)
+                {
+                    /* 如果当前线程不能被阻塞则函数直接返回 */
+                    if (uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK)
+                    {
+                        /* 保存线程挂起信息 */
+                        option |= IPC_OPT_PMQUEUE | IPC_OPT_READ_DATA;
+                        uIpcInitContext(&context, (void*)pMsgQue, (TBase32)pMsg2, sizeof(TBase32), option,
+                                        &state, &error);
+
+                        /* 当前线程阻塞在该消息队列的阻塞队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+                        uIpcBlockThread(&context, &(pMsgQue->Queue), timeo);
+
+                        /* 当前线程被阻塞，其它线程得以执行 */
+                        uThreadSchedule();
+
+                        CpuLeaveCritical(imask);
+                        /*
+                         * 因为当前线程已经阻塞在IPC对象的线程阻塞队列，所以处理器需要执行别的线程。
+                         * 当处理器再次处理本线程时，从本处继续运行。
+                         */
+                        CpuEnterCritical(&imask);
+
+                        /* 清除线程挂起信息 */
+                        uIpcCleanContext(&context);
+                    }
+                    else
+                    {
+                        error = IPC_ERR_ACAPI;
+                    }
+                }
+            }
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 用于线程/ISR向消息队列中发送指定优先级的消息                                           *
+ *  参数: (1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pMsg2    保存消息结构地址的指针变量                                                *
+ *        (3) priority 消息优先级，数值越小优先级越高                                            *
+ *        (4) option   访问消息队列的模式                                                        *
+ *        (5) timeo    时限阻塞模式下访问消息队列的时限长度                                      *
+ *        (6) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xPMQSend(TPrioMsgQueue* pMsgQue, TMessage* pMsg2, TPriority priority, TOption option,
+                TTimeTick timeo, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TIpcContext context;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+    if (pMsgQue->Property & IPC_PROP_READY)
+    {
+        state = SendPrioMessage(pMsgQue, (void**)pMsg2, priority, &HiRP, &error);
+
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U))
+        {
+            /* 如果当前线程解除了更高优先级线程的阻塞则进行调度。*/
+            if (state == eSuccess)
+            {
+                if (HiRP == eTrue)
+                {
+                    uThreadSchedule();
+                }
+            }
+            else
+            {
+                /*
+                 * 如果当前线程不能发送消息，并且采用的是等待方式，
+                 * 那么当前线程必须阻塞在消息队列中
+                 */
+                if (option & IPC_OPT_WAIT)
+                {
+                    /* 如果当前线程不能被阻塞则函数直接返回 */
+                    if (uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK)
+                    {
+                        /* 保存线程挂起信息，消息优先级借用Length保存 */
+                        option |= IPC_OPT_PMQUEUE | IPC_OPT_WRITE_DATA;
+                        uIpcInitContext(&context, (void*)pMsgQue, (TBase32)pMsg2, (TBase32)priority, option,
+                                        &state, &error);
+
+                        /* 当前线程阻塞在该消息队列的阻塞队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+                        uIpcBlockThread(&context, &(pMsgQue->Queue), timeo);
+
+                        /* 当前线程被阻塞，其它线程得以执行 */
+                        uThreadSchedule();
+
+                        CpuLeaveCritical(imask);
+                        /*
+                         * 因为当前线程已经阻塞在IPC对象的线程阻塞队列，所以处理器需要执行别的线程。
+                         * 当处理器再次处理本线程时，从本处继续运行。
+                         */
+                        CpuEnterCritical(&imask);
+
+                        /* 清除线程挂起信息 */
+                        uIpcCleanContext(&context);
+                    }
+                    else
+                    {
+                        error = IPC_ERR_ACAPI;
+                    }
+                }
+            }
+        }
+    }
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：多优先级消息队列初始化函数                                                             *
+ *  输入：(1) pMsgQue   消息队列结构地址                                                         *
+ *        (2) pName     消息队列名称                                                             *
+ *        (3) pNodes    消息节点数组地址                                                         *
+ *        (4) capacity  消息队列容量，即消息节点数组大小                                         *
+ *        (5) property  消息队列线程调度策略                                                     *
+ *        (6) pError    详细调用结果                                                             *
+ *  返回：(1) eSuccess  操作成功                                                                 *
+ *        (2) eFailure  操作失败                                                                 *
+ *  说明：全部优先级共用消息节点，每个消息只占用一个节点                                         *
+ *************************************************************************************************/
+TState xPMQCreate(TPrioMsgQueue* pMsgQue, TChar* pName, TPrioMsgNode* pNodes, TBase32 capacity,
+                  TProperty property, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_FAULT;
+    TBase32 index;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (!(pMsgQue->Property & IPC_PROP_READY))
+    {
+        /* 初始化消息队列对象信息 */
+        uKernelAddObject(&(pMsgQue->Object), pName, ePrioMessage, (void*)pMsgQue);
+
+        /* 初始化消息队列基本信息 */
+        property |= IPC_PROP_READY;
+        pMsgQue->Property   = property;
+        pMsgQue->Capacity   = capacity;
+        pMsgQue->MsgEntries = 0U;
+        pMsgQue->PrioMask   = (TBitMask)0;
+        memset(pMsgQue->Heads, 0, sizeof(pMsgQue->Heads));
+        memset(pMsgQue->Tails, 0, sizeof(pMsgQue->Tails));
+
+        /* 把全部消息节点串成空闲链表 */
+        for (index = 0U; index < capacity - 1U; index++)
+        {
+            pNodes[index].Next = &(pNodes[index + 1U]);
+        }
+        pNodes[capacity - 1U].Next = (TPrioMsgNode*)0;
+        pMsgQue->FreeList = pNodes;
+
+        uIpcInitQueue(&(pMsgQue->Queue), &(pMsgQue->Property));
+
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：多优先级消息队列删除函数                                                               *
+ *  输入：(1) pMsgQue   消息队列结构地址                                                         *
+ *        (2) pError    详细调用结果                                                             *
+ *  返回：(1) eSuccess  操作成功                                                                 *
+ *        (2) eFailure  操作失败                                                                 *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xPMQDelete(TPrioMsgQueue* pMsgQue, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pMsgQue->Property & IPC_PROP_READY)
+    {
+        /* 将阻塞队列上的所有等待线程都释放，所有线程的等待结果都是TCLE_IPC_DELETE */
+        uIpcUnblockAll(&(pMsgQue->Queue), eFailure, IPC_ERR_DELETE, (void**)0, &HiRP);
+
+        /* 从内核中移除消息队列对象 */
+        uKernelRemoveObject(&(pMsgQue->Object));
+
+        /* 清除消息队列对象的全部数据 */
+        memset(pMsgQue, 0U, sizeof(TPrioMsgQueue));
+
+        /*
+         * 在线程环境下，如果当前线程的优先级已经不再是线程就绪队列的最高优先级，
+         * 并且内核此时并没有关闭线程调度，那么就需要进行一次线程抢占
+         */
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+#endif
+
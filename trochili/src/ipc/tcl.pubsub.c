@@ -0,0 +1,540 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#include <string.h>
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.cpu.h"
+#include "tcl.debug.h"
+#include "tcl.thread.h"
+#include "tcl.kernel.h"
+#include "tcl.ipc.h"
+#include "tcl.mem.pool.h"
+#include "tcl.pubsub.h"
+
+#if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_PUBSUB_ENABLE)&&(TCLC_MEMORY_ENABLE)&&(TCLC_MEMORY_POOL_ENABLE))
+
+/* 由数据地址得到缓冲区头部地址 */
+#define TOPIC_BUFFER(data) ((TTopicBuffer*)((TByte*)(data) - sizeof(TTopicBuffer)))
+
+/*************************************************************************************************
+ *  功能：释放数据缓冲区的一个引用                                                               *
+ *  参数：(1) pTopic  主题结构地址                                                               *
+ *        (2) pData   数据地址                                                                   *
+ *        (3) pError  详细调用结果                                                               *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：引用计数从1变为0时缓冲区被归还到内存池；不属于内存池、已经归还或者引用计数已经为0的    *
+ *        缓冲区不做处理，返回IPC_ERR_FAULT                                                      *
+ *************************************************************************************************/
+static TState ReleaseBuffer(TTopic* pTopic, void* pData, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_FAULT;
+    TTopicBuffer* pBuffer = TOPIC_BUFFER(pData);
+    TError memError;
+
+    if ((uPoolMemCheck(pTopic->Pool, (void*)pBuffer) == eTrue) && (pBuffer->Refs > 0U))
+    {
+        pBuffer->Refs--;
+        if (pBuffer->Refs == 0U)
+        {
+            xPoolMemFree(pTopic->Pool, (void*)pBuffer, &memError);
+        }
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：解除订阅者和主题的关系                                                                 *
+ *  参数：(1) pSub    订阅者结构地址                                                             *
+ *        (2) pHiRP   是否需要线程调度标记                                                       *
+ *  返回：无                                                                                     *
+ *  说明：释放队列中全部数据的引用，等待数据的线程的等待结果都是IPC_ERR_DELETE                   *
+ *************************************************************************************************/
+static void DetachSubscriber(TSubscriber* pSub, TBool* pHiRP)
+{
+    TTopic* pTopic = pSub->Topic;
+    TSubscriber** pLink2;
+    TError error;
+
+    /* 从主题的订阅者链表中移除 */
+    pLink2 = &(pTopic->Subscribers);
+    while (*pLink2 != (TSubscriber*)0)
+    {
+        if (*pLink2 == pSub)
+        {
+            *pLink2 = pSub->Next;
+            break;
+        }
+        pLink2 = &((*pLink2)->Next);
+    }
+
+    /* 释放队列中尚未读取的数据 */
+    while (pSub->Count > 0U)
+    {
+        ReleaseBuffer(pTopic, pSub->Slots[pSub->Head], &error);
+        pSub->Head = (pSub->Head + 1U) % pSub->Depth;
+        pSub->Count--;
+    }
+
+    uIpcUnblockAll(&(pSub->Queue), eFailure, IPC_ERR_DELETE, (void**)0, pHiRP);
+    memset(pSub, 0U, sizeof(TSubscriber));
+}
+
+
+/*************************************************************************************************
+ *  功能：把数据投递到一个订阅者                                                                 *
+ *  参数：(1) pSub    订阅者结构地址                                                             *
+ *        (2) pData   数据地址                                                                   *
+ *        (3) pHiRP   是否需要线程调度标记                                                       *
+ *  返回：(1) eTrue   订阅者持有了该数据的一个引用                                               *
+ *        (2) eFalse  数据被丢弃                                                                 *
+ *  说明：队列满时按照订阅者的溢出策略丢弃最早的数据或者丢弃新数据                               *
+ *************************************************************************************************/
+static TBool DeliverBuffer(TSubscriber* pSub, void* pData, TBool* pHiRP)
+{
+    TIpcContext* pContext;
+    void* pOld;
+    TError error;
+
+    /* 队列空时阻塞队列里的线程在等待数据，把数据直接交给第一个线程 */
+    if ((pSub->Count == 0U) && (pSub->Property & IPC_PROP_PRIMQ_AVAIL))
+    {
+        pContext = (TIpcContext*)(pSub->Queue.PrimaryHandle->Owner);
+        uIpcUnblockThread(pContext, eSuccess, IPC_ERR_NONE, pHiRP);
+        *(pContext->Data.Addr2) = pData;
+    }
+    else if (pSub->Count < pSub->Depth)
+    {
+        pSub->Slots[pSub->Tail] = pData;
+        pSub->Tail = (pSub->Tail + 1U) % pSub->Depth;
+        pSub->Count++;
+    }
+    else if (pSub->Property & IPC_PROP_OVERWRITE)
+    {
+        /* 丢弃最早的数据，队列满时Head和Tail指向同一个槽位 */
+        pOld = pSub->Slots[pSub->Tail];
+        pSub->Slots[pSub->Tail] = pData;
+        pSub->Tail = (pSub->Tail + 1U) % pSub->Depth;
+        pSub->Head = pSub->Tail;
+        pSub->Dropped++;
+        ReleaseBuffer(pSub->Topic, pOld, &error);
+    }
+    else
+    {
+        /* 丢弃新数据 */
+        pSub->Dropped++;
+        return eFalse;
+    }
+
+    return eTrue;
+}
+
+
+/*************************************************************************************************
+ *  功能：从主题的内存池中借出一个数据缓冲区                                                     *
+ *  参数：(1) pTopic  主题结构地址                                                               *
+ *        (2) pData2  保存数据地址的指针变量                                                     *
+ *        (3) pError  详细调用结果                                                               *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：生产者直接在缓冲区中填写数据，然后发布或者释放该缓冲区；借出的缓冲区持有生产者的引用   *
+ *************************************************************************************************/
+TState xTopicLoan(TTopic* pTopic, void** pData2, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TError memError;
+    void* pBuffer;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pTopic->Property & IPC_PROP_READY)
+    {
+        state = xPoolMemMalloc(pTopic->Pool, &pBuffer, &memError);
+        if (state == eSuccess)
+        {
+            ((TTopicBuffer*)pBuffer)->Refs = 1U;
+            *pData2 = (void*)((TByte*)pBuffer + sizeof(TTopicBuffer));
+            error = IPC_ERR_NONE;
+        }
+        else
+        {
+            error = IPC_ERR_NORMAL;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：向主题的全部订阅者发布数据                                                             *
+ *  参数：(1) pTopic  主题结构地址                                                               *
+ *        (2) pData   借出的数据缓冲区地址                                                       *
+ *        (3) length  数据长度                                                                   *
+ *        (4) pError  详细调用结果                                                               *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：数据不被复制，每个订阅者持有缓冲区的一个引用；发布者从不阻塞，可以在ISR中调用；        *
+ *        发布之后生产者的引用被释放，没有订阅者持有的缓冲区立即归还内存池                       *
+ *************************************************************************************************/
+TState xTopicPublish(TTopic* pTopic, void* pData, TBase32 length, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TTopicBuffer* pBuffer = TOPIC_BUFFER(pData);
+    TSubscriber* pSub;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pTopic->Property & IPC_PROP_READY)
+    {
+        /* 只能发布借出后仍然持有生产者引用的缓冲区 */
+        if ((uPoolMemCheck(pTopic->Pool, (void*)pBuffer) == eTrue) && (pBuffer->Refs > 0U))
+        {
+            pBuffer->Length = length;
+
+            pSub = pTopic->Subscribers;
+            while (pSub != (TSubscriber*)0)
+            {
+                if (DeliverBuffer(pSub, pData, &HiRP) == eTrue)
+                {
+                    pBuffer->Refs++;
+                }
+                pSub = pSub->Next;
+            }
+
+            /* 释放生产者的引用，没有订阅者持有该数据则缓冲区被归还 */
+            state = ReleaseBuffer(pTopic, pData, &error);
+
+            if ((uKernelVariable.State == eThreadState) &&
+                    (uKernelVariable.SchedLockTimes == 0U) &&
+                    (HiRP == eTrue))
+            {
+                uThreadSchedule();
+            }
+        }
+        else
+        {
+            error = IPC_ERR_FAULT;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：订阅者接收主题数据                                                                     *
+ *  参数：(1) pSub    订阅者结构地址                                                             *
+ *        (2) pData2  保存数据地址的指针变量                                                     *
+ *        (3) pLength 保存数据长度的变量                                                         *
+ *        (4) option  访问订阅者的模式                                                           *
+ *        (5) timeo   时限阻塞模式下等待数据的时限长度                                           *
+ *        (6) pError  详细调用结果                                                               *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：接收者持有数据缓冲区的一个引用，使用完毕后必须调用xTopicRelease                        *
+ *************************************************************************************************/
+TState xTopicReceive(TSubscriber* pSub, void** pData2, TBase32* pLength, TOption option,
+                     TTimeTick timeo, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TIpcContext context;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pSub->Property & IPC_PROP_READY)
+    {
+        if (pSub->Count > 0U)
+        {
+            *pData2 = pSub->Slots[pSub->Head];
+            pSub->Head = (pSub->Head + 1U) % pSub->Depth;
+            pSub->Count--;
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = IPC_ERR_NORMAL;
+
+            if ((uKernelVariable.State == eThreadState) &&
+                    (uKernelVariable.SchedLockTimes == 0U) &&
+                    (option & IPC_OPT_WAIT))
+            {
+                /* 如果当前线程不能被阻塞则函数直接返回 */
+                if (uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK)
+                {
+                    /* 保存线程挂起信息 */
+                    option |= IPC_OPT_TOPIC | IPC_OPT_READ_DATA;
+                    uIpcInitContext(&context, (void*)pSub, (TBase32)pData2, sizeof(TBase32), option,
+                                    &state, &error);
+
+                    /* 当前线程阻塞在该订阅者的阻塞队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+                    uIpcBlockThread(&context, &(pSub->Queue), timeo);
+
+                    /* 当前线程被阻塞，其它线程得以执行 */
+                    uThreadSchedule();
+
+                    CpuLeaveCritical(imask);
+                    /*
+                     * 因为当前线程已经阻塞在IPC对象的线程阻塞队列，所以处理器需要执行别的线程。
+                     * 当处理器再次处理本线程时，从本处继续运行。
+                     */
+                    CpuEnterCritical(&imask);
+
+                    /* 清除线程挂起信息 */
+                    uIpcCleanContext(&context);
+                }
+                else
+                {
+                    error = IPC_ERR_ACAPI;
+                }
+            }
+        }
+
+        if (state == eSuccess)
+        {
+            *pLength = TOPIC_BUFFER(*pData2)->Length;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：释放数据缓冲区的引用                                                                   *
+ *  参数：(1) pTopic  主题结构地址                                                               *
+ *        (2) pData   数据地址                                                                   *
+ *        (3) pError  详细调用结果                                                               *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：接收者用完数据后调用；借出后没有发布的缓冲区也用本函数归还；重复释放返回IPC_ERR_FAULT  *
+ *************************************************************************************************/
+TState xTopicRelease(TTopic* pTopic, void* pData, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pTopic->Property & IPC_PROP_READY)
+    {
+        state = ReleaseBuffer(pTopic, pData, &error);
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：订阅主题                                                                               *
+ *  参数：(1) pTopic   主题结构地址                                                              *
+ *        (2) pSub     订阅者结构地址                                                            *
+ *        (3) pSlots   订阅者数据槽位数组地址                                                    *
+ *        (4) depth    槽位数目                                                                  *
+ *        (5) property 订阅者属性，IPC_PROP_OVERWRITE表示队列满时丢弃最早的数据                  *
+ *        (6) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：订阅之后发布的数据才会进入订阅者的队列                                                 *
+ *************************************************************************************************/
+TState xTopicSubscribe(TTopic* pTopic, TSubscriber* pSub, void** pSlots, TBase32 depth,
+                       TProperty property, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pTopic->Property & IPC_PROP_READY)
+    {
+        if (!(pSub->Property & IPC_PROP_READY))
+        {
+            property |= IPC_PROP_READY;
+            pSub->Property = property;
+            pSub->Topic    = pTopic;
+            pSub->Slots    = pSlots;
+            pSub->Depth    = depth;
+            pSub->Count    = 0U;
+            pSub->Head     = 0U;
+            pSub->Tail     = 0U;
+            pSub->Dropped  = 0U;
+            uIpcInitQueue(&(pSub->Queue), &(pSub->Property));
+
+            pSub->Next = pTopic->Subscribers;
+            pTopic->Subscribers = pSub;
+
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = IPC_ERR_FAULT;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：取消订阅主题                                                                           *
+ *  参数：(1) pSub     订阅者结构地址                                                            *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：注意线程的等待结果都是IPC_ERR_DELETE                                                   *
+ *************************************************************************************************/
+TState xTopicUnsubscribe(TSubscriber* pSub, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pSub->Property & IPC_PROP_READY)
+    {
+        DetachSubscriber(pSub, &HiRP);
+
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：主题初始化函数                                                                         *
+ *  参数：(1) pTopic   主题结构地址                                                              *
+ *        (2) pName    主题名称                                                                  *
+ *        (3) pPool    数据缓冲区所在的内存池                                                    *
+ *        (4) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：内存池的内存页大小决定了一次发布的最大数据长度                                         *
+ *************************************************************************************************/
+TState xTopicCreate(TTopic* pTopic, TChar* pName, TMemPool* pPool, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_FAULT;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (!(pTopic->Property & IPC_PROP_READY))
+    {
+        uKernelAddObject(&(pTopic->Object), pName, eTopic, (void*)pTopic);
+
+        pTopic->Property    = IPC_PROP_READY;
+        pTopic->Pool        = pPool;
+        pTopic->Subscribers = (TSubscriber*)0;
+
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：主题删除函数                                                                           *
+ *  参数：(1) pTopic   主题结构地址                                                              *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：全部订阅者被取消订阅，接收者仍然持有的缓冲区随内存池一起回收                           *
+ *************************************************************************************************/
+TState xTopicDelete(TTopic* pTopic, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pTopic->Property & IPC_PROP_READY)
+    {
+        while (pTopic->Subscribers != (TSubscriber*)0)
+        {
+            DetachSubscriber(pTopic->Subscribers, &HiRP);
+        }
+
+        /* 从内核中移除主题对象 */
+        uKernelRemoveObject(&(pTopic->Object));
+
+        /* 清除主题对象的全部数据 */
+        memset(pTopic, 0U, sizeof(TTopic));
+
+        /*
+         * 在线程环境下，如果当前线程的优先级已经不再是线程就绪队列的最高优先级，
+         * 并且内核此时并没有关闭线程调度，那么就需要进行一次线程抢占
+         */
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+#endif
+
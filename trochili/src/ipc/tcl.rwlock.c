@@ -0,0 +1,402 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#include <string.h>
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.cpu.h"
+#include "tcl.thread.h"
+#include "tcl.debug.h"
+#include "tcl.kernel.h"
+#include "tcl.ipc.h"
+#include "tcl.rwlock.h"
+
+#if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_RWLOCK_ENABLE))
+
+/*************************************************************************************************
+ *  功能: 把空闲的读写锁转交给阻塞队列中的线程                                                   *
+ *  参数: (1) pRwLock    读写锁结构地址                                                          *
+ *        (2) pHiRP      是否存在高就绪优先级标记                                                *
+ *  返回: 无                                                                                     *
+ *  说明：写锁优先，如果读写锁完全空闲并且有线程在等待写锁，则让写队列中的第一个线程获得写锁;    *
+ *        如果既没有线程持有写锁也没有线程等待写锁，则唤醒全部等待读锁的线程。                   *
+ *************************************************************************************************/
+static void GrantRwLock(TRwLock* pRwLock, TBool* pHiRP)
+{
+    TIpcContext* pContext;
+
+    if (pRwLock->Writer == (TThread*)0)
+    {
+        if (pRwLock->Property & IPC_PROP_PRIMQ_AVAIL)
+        {
+            if (pRwLock->Readers == 0U)
+            {
+                pContext = (TIpcContext*)(pRwLock->Queue.PrimaryHandle->Owner);
+                pRwLock->Writer = (TThread*)(pContext->Owner);
+                uIpcUnblockThread(pContext, eSuccess, IPC_ERR_NONE, pHiRP);
+            }
+        }
+        else
+        {
+            while (pRwLock->Property & IPC_PROP_AUXIQ_AVAIL)
+            {
+                pContext = (TIpcContext*)(pRwLock->Queue.AuxiliaryHandle->Owner);
+                pRwLock->Readers++;
+                uIpcUnblockThread(pContext, eSuccess, IPC_ERR_NONE, pHiRP);
+            }
+        }
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能: 等待写锁的线程被解除阻塞时的回调函数
+ *  参数: (1) pContext   线程的IPC阻塞信息
+ *        (2) state      线程的等待结果
+ *  返回: 无
+ *  说明：等待写锁的线程因为超时或者中止等原因离开阻塞队列时，被它挡住的读线程可能已经可以
+ *        获得读锁，需要立即转交读写锁，而不是等到下一次解锁
+ *************************************************************************************************/
+static void RwLockWakeup(TIpcContext* pContext, TState state)
+{
+    TRwLock* pRwLock;
+    TBool HiRP = eFalse;
+
+    pRwLock = (TRwLock*)(pContext->Object);
+
+    /* 读写锁被删除时不再转交 */
+    if ((state != eSuccess) && (pRwLock->Property & IPC_PROP_READY))
+    {
+        GrantRwLock(pRwLock, &HiRP);
+
+        /* 在中断中被唤醒时(例如超时)，退出中断时会进行线程调度 */
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR获得读锁                                                                       *
+ *  参数: (1) pRwLock    读写锁结构地址                                                          *
+ *        (2) option     访问读写锁的模式                                                        *
+ *        (3) timeo      时限阻塞模式下访问读写锁的时限长度                                      *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：ISR只能以非阻塞方式尝试获得读锁，读锁不记录持有者，ISR获得的读锁由ISR自行释放          *
+ *************************************************************************************************/
+TState xRwLockRead(TRwLock* pRwLock, TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TIpcContext context;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pRwLock->Property & IPC_PROP_READY)
+    {
+        /* 没有线程持有写锁，并且没有线程在等待写锁时才能获得读锁 */
+        if ((pRwLock->Writer == (TThread*)0) &&
+                (!(pRwLock->Property & IPC_PROP_PRIMQ_AVAIL)))
+        {
+            pRwLock->Readers++;
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = IPC_ERR_NORMAL;
+
+            /*
+             * 如果当前线程不能得到读锁，并且采用的是等待方式，
+             * 那么当前线程必须阻塞在读写锁的辅助队列中
+             */
+            if ((uKernelVariable.State == eThreadState) &&
+                    (uKernelVariable.SchedLockTimes == 0U) &&
+                    (option & IPC_OPT_WAIT))
+            {
+                /* 如果当前线程不能被阻塞则函数直接返回 */
+                if (uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK)
+                {
+                    /* 设定线程正在等待的资源的信息 */
+                    uIpcInitContext(&context, (void*)pRwLock, 0U, 0U,
+                                    option | IPC_OPT_RWLOCK | IPC_OPT_USE_AUXIQ, &state, &error);
+
+                    /* 当前线程阻塞在读写锁的辅助队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+                    uIpcBlockThread(&context, &(pRwLock->Queue), timeo);
+
+                    /* 当前线程被阻塞，其它线程得以执行 */
+                    uThreadSchedule();
+
+                    CpuLeaveCritical(imask);
+                    /*
+                     * 因为当前线程已经阻塞在IPC对象的线程阻塞队列，所以处理器需要执行别的线程。
+                     * 当处理器再次处理本线程时，从本处继续运行。
+                     */
+                    CpuEnterCritical(&imask);
+
+                    /* 清除线程挂起信息 */
+                    uIpcCleanContext(&context);
+                }
+                else
+                {
+                    error = IPC_ERR_ACAPI;
+                }
+            }
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程获得写锁                                                                           *
+ *  参数: (1) pRwLock    读写锁结构地址                                                          *
+ *        (2) option     访问读写锁的模式                                                        *
+ *        (3) timeo      时限阻塞模式下访问读写锁的时限长度                                      *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：写锁不可重入，持有读锁的线程不能再申请写锁，读写锁也不提供优先级继承                   *
+ *************************************************************************************************/
+TState xRwLockWrite(TRwLock* pRwLock, TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TIpcContext context;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    /* 只允许在线程代码里调用本函数 */
+    if (uKernelVariable.State != eThreadState)
+    {
+        uKernelVariable.Diagnosis |= KERNEL_DIAG_IRQ_ERROR;
+        uDebugPanic("", __FILE__, __FUNCTION__, __LINE__);
+    }
+
+    if (pRwLock->Property & IPC_PROP_READY)
+    {
+        if ((pRwLock->Writer == (TThread*)0) && (pRwLock->Readers == 0U))
+        {
+            pRwLock->Writer = uKernelVariable.CurrentThread;
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = IPC_ERR_NORMAL;
+
+            /* 写锁已经属于当前线程时不能再阻塞等待，否则线程将永远无法被唤醒 */
+            if ((pRwLock->Writer != uKernelVariable.CurrentThread) &&
+                    (uKernelVariable.SchedLockTimes == 0U) &&
+                    (option & IPC_OPT_WAIT))
+            {
+                /* 如果当前线程不能被阻塞则函数直接返回 */
+                if (uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK)
+                {
+                    /* 设定线程正在等待的资源的信息 */
+                    uIpcInitContext(&context, (void*)pRwLock, 0U, 0U,
+                                    option | IPC_OPT_RWLOCK, &state, &error);
+                    context.Wakeup = RwLockWakeup;
+
+                    /* 当前线程阻塞在读写锁的基本队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+                    uIpcBlockThread(&context, &(pRwLock->Queue), timeo);
+
+                    /* 当前线程被阻塞，其它线程得以执行 */
+                    uThreadSchedule();
+
+                    CpuLeaveCritical(imask);
+                    /*
+                     * 因为当前线程已经阻塞在IPC对象的线程阻塞队列，所以处理器需要执行别的线程。
+                     * 当处理器再次处理本线程时，从本处继续运行。
+                     */
+                    CpuEnterCritical(&imask);
+
+                    /* 清除线程挂起信息 */
+                    uIpcCleanContext(&context);
+                }
+                else
+                {
+                    error = IPC_ERR_ACAPI;
+                }
+            }
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR释放读写锁                                                                     *
+ *  参数: (1) pRwLock    读写锁结构地址                                                          *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：如果当前线程持有写锁则释放写锁，否则释放一个读锁。ISR只能释放读锁                      *
+ *************************************************************************************************/
+TState xRwLockUnlock(TRwLock* pRwLock, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBool HiRP = eFalse;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pRwLock->Property & IPC_PROP_READY)
+    {
+        error = IPC_ERR_NORMAL;
+        if ((uKernelVariable.State == eThreadState) &&
+                (pRwLock->Writer == uKernelVariable.CurrentThread))
+        {
+            pRwLock->Writer = (TThread*)0;
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+        else if (pRwLock->Readers != 0U)
+        {
+            pRwLock->Readers--;
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            ;
+        }
+
+        if (state == eSuccess)
+        {
+            /* 尝试把读写锁转交给阻塞队列中的线程 */
+            GrantRwLock(pRwLock, &HiRP);
+
+            /* 如果当前线程解除了更高优先级线程的阻塞则进行调度。*/
+            if ((uKernelVariable.State == eThreadState) &&
+                    (uKernelVariable.SchedLockTimes == 0U) &&
+                    (HiRP == eTrue))
+            {
+                uThreadSchedule();
+            }
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 初始化读写锁                                                                           *
+ *  参数: (1) pRwLock    读写锁结构地址                                                          *
+ *        (2) pName      读写锁名称                                                              *
+ *        (3) property   读写锁的初始属性                                                        *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：基本队列保存等待写锁的线程，辅助队列保存等待读锁的线程                                 *
+ *************************************************************************************************/
+TState xRwLockCreate(TRwLock* pRwLock, TChar* pName, TProperty property, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_FAULT;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (!(pRwLock->Property & IPC_PROP_READY))
+    {
+        /* 初始化读写锁对象信息 */
+        uKernelAddObject(&(pRwLock->Object), pName, eRwLock, (void*)pRwLock);
+
+        /* 初始化读写锁基本信息 */
+        property |= IPC_PROP_READY;
+        pRwLock->Property = property;
+        pRwLock->Readers  = 0U;
+        pRwLock->Writer   = (TThread*)0;
+        uIpcInitQueue(&(pRwLock->Queue), &(pRwLock->Property));
+
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 读写锁删除                                                                             *
+ *  参数: (1) pRwLock    读写锁结构地址                                                          *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xRwLockDelete(TRwLock* pRwLock, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TReg32 imask;
+    TBool HiRP = eFalse;
+
+    CpuEnterCritical(&imask);
+
+    if (pRwLock->Property & IPC_PROP_READY)
+    {
+        /*
+         * 调用下面的函数时会记录是否有优先级更高的线程就绪，但不记录具体是哪个线程
+         * 将读写锁阻塞队列上的所有等待线程都释放，所有线程的等待结果都是TCLE_IPC_DELETE；
+         * 先清除就绪标记，避免等待写锁的线程被唤醒时又把读写锁转交给其它线程
+         */
+        pRwLock->Property &= ~IPC_PROP_READY;
+        uIpcUnblockAll(&(pRwLock->Queue), eFailure, IPC_ERR_DELETE, (void**)0, &HiRP);
+
+        /* 从内核中移除读写锁 */
+        uKernelRemoveObject(&(pRwLock->Object));
+
+        /* 清除读写锁对象的全部数据 */
+        memset(pRwLock, 0U, sizeof(TRwLock));
+
+        /*
+         * 在线程环境下，如果当前线程的优先级已经不再是线程就绪队列的最高优先级，
+         * 并且内核此时并没有关闭线程调度，那么就需要进行一次线程抢占
+         */
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+#endif
+
@@ -314,9 +314,7 @@ TState xSemaphoreCreate(TSemaphore* pSemaphore, TChar* pName, TBase32 value, TBa
         pSemaphore->Value        = value;
         pSemaphore->LimitedValue = mvalue;
         pSemaphore->InitialValue = value;
-        pSemaphore->Queue.PrimaryHandle   = (TLinkNode*)0;
-        pSemaphore->Queue.AuxiliaryHandle = (TLinkNode*)0;
-        pSemaphore->Queue.Property        = &(pSemaphore->Property);
+        uIpcInitQueue(&(pSemaphore->Queue), &(pSemaphore->Property));
 
         error = IPC_ERR_NONE;
         state = eSuccess;
@@ -0,0 +1,377 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#include <string.h>
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.cpu.h"
+#include "tcl.thread.h"
+#include "tcl.debug.h"
+#include "tcl.kernel.h"
+#include "tcl.ipc.h"
+#include "tcl.stream.h"
+
+#if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_STREAM_ENABLE))
+
+/*************************************************************************************************
+ *  功能: 计算字节流缓冲区中可以读取的字节数                                                     *
+ *  参数: (1) pStream    字节流缓冲区结构地址                                                    *
+ *  返回: 可以读取的字节数                                                                       *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+static TBase32 GetStreamLength(TStreamBuffer* pStream)
+{
+    TBase32 head;
+    TBase32 tail;
+    TBase32 length;
+
+    head = pStream->Head;
+    tail = pStream->Tail;
+    if (head >= tail)
+    {
+        length = head - tail;
+    }
+    else
+    {
+        length = pStream->Size - tail + head;
+    }
+
+    return length;
+}
+
+
+/*************************************************************************************************
+ *  功能: 生产者向字节流缓冲区写入数据                                                           *
+ *  参数: (1) pStream    字节流缓冲区结构地址                                                    *
+ *        (2) pData      待写入的数据地址                                                        *
+ *        (3) length     待写入的字节数                                                          *
+ *  返回: 实际写入的字节数                                                                       *
+ *  说明：先写入数据再更新写入位置，消费者看到新的写入位置时数据一定已经就绪                     *
+ *************************************************************************************************/
+static TBase32 WriteStream(TStreamBuffer* pStream, TByte* pData, TBase32 length)
+{
+    TBase32 head;
+    TBase32 next;
+    TBase32 count = 0U;
+
+    head = pStream->Head;
+    while (count < length)
+    {
+        next = head + 1U;
+        if (next == pStream->Size)
+        {
+            next = 0U;
+        }
+
+        /* 缓冲区已满 */
+        if (next == pStream->Tail)
+        {
+            break;
+        }
+
+        pStream->Buffer[head] = pData[count];
+        head = next;
+        count++;
+    }
+    pStream->Head = head;
+
+    return count;
+}
+
+
+/*************************************************************************************************
+ *  功能: 消费者从字节流缓冲区读取数据                                                           *
+ *  参数: (1) pStream    字节流缓冲区结构地址                                                    *
+ *        (2) pData      保存数据的地址                                                          *
+ *        (3) length     最多读取的字节数                                                        *
+ *  返回: 实际读取的字节数                                                                       *
+ *  说明：先读出数据再更新读取位置，生产者看到新的读取位置时这些空间才会被重新写入               *
+ *************************************************************************************************/
+static TBase32 ReadStream(TStreamBuffer* pStream, TByte* pData, TBase32 length)
+{
+    TBase32 head;
+    TBase32 tail;
+    TBase32 count = 0U;
+
+    head = pStream->Head;
+    tail = pStream->Tail;
+    while ((count < length) && (tail != head))
+    {
+        pData[count] = pStream->Buffer[tail];
+        tail++;
+        if (tail == pStream->Size)
+        {
+            tail = 0U;
+        }
+        count++;
+    }
+    pStream->Tail = tail;
+
+    return count;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR向字节流缓冲区写入数据                                                         *
+ *  参数: (1) pStream    字节流缓冲区结构地址                                                    *
+ *        (2) pData      待写入的数据地址                                                        *
+ *        (3) length     待写入的字节数                                                          *
+ *        (4) pCount     实际写入的字节数                                                        *
+ *        (5) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：写入操作从不阻塞，缓冲区空间不足时只写入部分数据。只有在读线程阻塞并且数据达到触发     *
+ *        字节数时才进入临界区唤醒读线程                                                         *
+ *************************************************************************************************/
+TState xStreamBufferSend(TStreamBuffer* pStream, TByte* pData, TBase32 length, TBase32* pCount,
+                         TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBase32 count = 0U;
+    TBool HiRP = eFalse;
+    TIpcContext* pContext;
+    TReg32 imask;
+
+    if (pStream->Property & IPC_PROP_READY)
+    {
+        count = WriteStream(pStream, pData, length);
+        if (count == 0U)
+        {
+            error = IPC_ERR_NORMAL;
+        }
+        else
+        {
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+
+            /*
+             * 读线程在临界区内检查缓冲区并阻塞，所以这里看不到阻塞标记时读线程一定还能看到
+             * 新写入的数据，不会丢失唤醒
+             */
+            if ((pStream->Property & IPC_PROP_PRIMQ_AVAIL) &&
+                    (GetStreamLength(pStream) >= pStream->Trigger))
+            {
+                CpuEnterCritical(&imask);
+                if (pStream->Property & IPC_PROP_PRIMQ_AVAIL)
+                {
+                    pContext = (TIpcContext*)(pStream->Queue.PrimaryHandle->Owner);
+                    uIpcUnblockThread(pContext, eSuccess, IPC_ERR_NONE, &HiRP);
+
+                    if ((uKernelVariable.State == eThreadState) &&
+                            (uKernelVariable.SchedLockTimes == 0U) &&
+                            (HiRP == eTrue))
+                    {
+                        uThreadSchedule();
+                    }
+                }
+                CpuLeaveCritical(imask);
+            }
+        }
+    }
+
+    *pCount = count;
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR从字节流缓冲区读取数据                                                         *
+ *  参数: (1) pStream    字节流缓冲区结构地址                                                    *
+ *        (2) pData      保存数据的地址                                                          *
+ *        (3) length     最多读取的字节数                                                        *
+ *        (4) pCount     实际读取的字节数                                                        *
+ *        (5) option     读取字节流的模式                                                        *
+ *        (6) timeo      时限阻塞模式下读取字节流的时限长度                                      *
+ *        (7) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：缓冲区不空时直接读取，不进入临界区;缓冲区为空时读线程阻塞，直到数据达到触发字节数，    *
+ *        时限到达时读取已有的数据                                                               *
+ *************************************************************************************************/
+TState xStreamBufferReceive(TStreamBuffer* pStream, TByte* pData, TBase32 length,
+                            TBase32* pCount, TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TBase32 count = 0U;
+    TIpcContext context;
+    TReg32 imask;
+
+    if (pStream->Property & IPC_PROP_READY)
+    {
+        count = ReadStream(pStream, pData, length);
+        if (count != 0U)
+        {
+            error = IPC_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = IPC_ERR_NORMAL;
+
+            /*
+             * 如果缓冲区中没有数据，并且采用的是等待方式，
+             * 那么当前线程必须阻塞在字节流缓冲区的阻塞队列中
+             */
+            if ((uKernelVariable.State == eThreadState) &&
+                    (uKernelVariable.SchedLockTimes == 0U) &&
+                    (option & IPC_OPT_WAIT))
+            {
+                /* 如果当前线程不能被阻塞则函数直接返回 */
+                if (uKernelVariable.CurrentThread->ACAPI & THREAD_ACAPI_BLOCK)
+                {
+                    CpuEnterCritical(&imask);
+
+                    /* 在临界区内再次检查缓冲区，防止生产者在前面的检查之后写入了数据 */
+                    if (pStream->Head == pStream->Tail)
+                    {
+                        /* 设定线程正在等待的资源的信息 */
+                        uIpcInitContext(&context, (void*)pStream, 0U, 0U,
+                                        option | IPC_OPT_STREAM, &state, &error);
+
+                        /* 当前线程阻塞在该缓冲区的阻塞队列，时限或者无限等待，由IPC_OPT_TIMEO参数决定 */
+                        uIpcBlockThread(&context, &(pStream->Queue), timeo);
+
+                        /* 当前线程被阻塞，其它线程得以执行 */
+                        uThreadSchedule();
+
+                        CpuLeaveCritical(imask);
+                        /*
+                         * 因为当前线程已经阻塞在IPC对象的线程阻塞队列，所以处理器需要执行别的线程。
+                         * 当处理器再次处理本线程时，从本处继续运行。
+                         */
+                        CpuEnterCritical(&imask);
+
+                        /* 清除线程挂起信息 */
+                        uIpcCleanContext(&context);
+                    }
+                    CpuLeaveCritical(imask);
+
+                    /* 缓冲区被删除时不再读取数据，其它情况下读取缓冲区中已有的数据 */
+                    if (pStream->Property & IPC_PROP_READY)
+                    {
+                        count = ReadStream(pStream, pData, length);
+                        if (count != 0U)
+                        {
+                            error = IPC_ERR_NONE;
+                            state = eSuccess;
+                        }
+                    }
+                }
+                else
+                {
+                    error = IPC_ERR_ACAPI;
+                }
+            }
+        }
+    }
+
+    *pCount = count;
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 初始化字节流缓冲区                                                                     *
+ *  参数: (1) pStream    字节流缓冲区结构地址                                                    *
+ *        (2) pName      字节流缓冲区名称                                                        *
+ *        (3) pBuffer    环形缓冲区地址                                                          *
+ *        (4) size       环形缓冲区长度                                                          *
+ *        (5) trigger    唤醒读线程需要的最少字节数                                              *
+ *        (6) property   字节流缓冲区的初始属性                                                  *
+ *        (7) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：字节流缓冲区只使用基本IPC队列                                                          *
+ *************************************************************************************************/
+TState xStreamBufferCreate(TStreamBuffer* pStream, TChar* pName, TByte* pBuffer, TBase32 size,
+                           TBase32 trigger, TProperty property, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_FAULT;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (!(pStream->Property & IPC_PROP_READY))
+    {
+        /* 初始化字节流缓冲区对象信息 */
+        uKernelAddObject(&(pStream->Object), pName, eStreamBuffer, (void*)pStream);
+
+        /* 初始化字节流缓冲区基本信息 */
+        property |= IPC_PROP_READY;
+        pStream->Property = property;
+        pStream->Buffer   = pBuffer;
+        pStream->Size     = size;
+        pStream->Trigger  = trigger;
+        pStream->Head     = 0U;
+        pStream->Tail     = 0U;
+        uIpcInitQueue(&(pStream->Queue), &(pStream->Property));
+
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 字节流缓冲区删除                                                                       *
+ *  参数: (1) pStream    字节流缓冲区结构地址                                                    *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：调用者需要保证此时生产者不再写入数据                                                   *
+ *************************************************************************************************/
+TState xStreamBufferDelete(TStreamBuffer* pStream, TError* pError)
+{
+    TState state = eFailure;
+    TError error = IPC_ERR_UNREADY;
+    TReg32 imask;
+    TBool HiRP = eFalse;
+
+    CpuEnterCritical(&imask);
+
+    if (pStream->Property & IPC_PROP_READY)
+    {
+        /* 将阻塞队列上的读线程释放，等待结果是TCLE_IPC_DELETE */
+        uIpcUnblockAll(&(pStream->Queue), eFailure, IPC_ERR_DELETE, (void**)0, &HiRP);
+
+        /* 从内核中移除字节流缓冲区 */
+        uKernelRemoveObject(&(pStream->Object));
+
+        /* 清除字节流缓冲区对象的全部数据 */
+        memset(pStream, 0U, sizeof(TStreamBuffer));
+
+        /*
+         * 在线程环境下，如果当前线程的优先级已经不再是线程就绪队列的最高优先级，
+         * 并且内核此时并没有关闭线程调度，那么就需要进行一次线程抢占
+         */
+        if ((uKernelVariable.State == eThreadState) &&
+                (uKernelVariable.SchedLockTimes == 0U) &&
+                (HiRP == eTrue))
+        {
+            uThreadSchedule();
+        }
+        error = IPC_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+#endif
+
@@ -231,5 +231,44 @@ TState xPoolMemFree (TMemPool* pPool, void* pAddr, TError* pError)
     return state;
 }
 
+
+/*************************************************************************************************
+ *  功能: 检查地址是否是内存池中一个已经分配出去的内存页                                         *
+ *  参数: (1) pPool      内存池结构地址                                                          *
+ *        (2) pAddr      被检查的内存地址                                                        *
+ *  返回: (1) eTrue      地址是已分配内存页的首地址                                              *
+ *        (2) eFalse     地址不属于内存池、不在内存页首地址上，或者内存页尚未分配                *
+ *  说明：在临界区内调用，用于在访问借出的内存页之前确认它仍然归调用者所有                       *
+ *************************************************************************************************/
+TBool uPoolMemCheck(TMemPool* pPool, void* pAddr)
+{
+    TIndex index;
+    TBase32 x;
+    TBase32 y;
+
+    if ((!(pPool->Property & MEM_PROP_READY)) || ((TChar*)pAddr < pPool->PageAddr))
+    {
+        return eFalse;
+    }
+
+    /* 地址必须处在某个内存页的首地址上 */
+    index = ((TChar*)pAddr - pPool->PageAddr) / (pPool->PageSize);
+    if ((index >= pPool->PageNbr) ||
+            ((pPool->PageAddr + index * pPool->PageSize) != (TChar*)pAddr))
+    {
+        return eFalse;
+    }
+
+    /* 内存页管理标记为0说明该内存页已经被分配出去 */
+    y = (index >> 5);
+    x = (index & 0x1f);
+    if (pPool->PageTags[y] & (0x1 << x))
+    {
+        return eFalse;
+    }
+
+    return eTrue;
+}
+
 #endif
 
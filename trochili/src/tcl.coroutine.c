@@ -0,0 +1,238 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#include <string.h>
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.cpu.h"
+#include "tcl.debug.h"
+#include "tcl.kernel.h"
+#include "tcl.ipc.h"
+#include "tcl.semaphore.h"
+#include "tcl.coroutine.h"
+
+#if ((TCLC_COROUTINE_ENABLE) && (TCLC_IPC_ENABLE) && (TCLC_IPC_SEMAPHORE_ENABLE))
+
+/*************************************************************************************************
+ *  功能：设置协程延时                                                                           *
+ *  参数：(1) pCoroutine 协程结构地址                                                            *
+ *        (2) ticks      延时的时钟节拍数                                                        *
+ *  返回：无                                                                                     *
+ *  说明：只在协程函数中通过TCLM_CO_DELAY调用                                                    *
+ *************************************************************************************************/
+void uCoroutineSetDelay(TCoroutine* pCoroutine, TTimeTick ticks)
+{
+    TTimeTick jiffies;
+
+    xKernelGetJiffies(&jiffies);
+    pCoroutine->WakeTicks = jiffies + ticks;
+}
+
+
+/*************************************************************************************************
+ *  功能：初始化协程调度器                                                                       *
+ *  参数：(1) pScheduler 协程调度器结构地址                                                      *
+ *        (2) pName      协程调度器名称                                                          *
+ *        (3) ticks      等待条件的协程的轮询周期                                                *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xCoSchedulerCreate(TCoScheduler* pScheduler, TChar* pName, TTimeTick ticks,
+                          TError* pError)
+{
+    TState state = eFailure;
+    TError error = COROUTINE_ERR_FAULT;
+    TError ipcError;
+
+    if (!(pScheduler->Property & COROUTINE_PROP_READY))
+    {
+        state = xSemaphoreCreate(&(pScheduler->Signal), pName, 0U, 1U,
+                                 IPC_PROP_DEFAULT, &ipcError);
+        if (state == eSuccess)
+        {
+            pScheduler->PollTicks = ticks;
+            pScheduler->Handle = (TLinkNode*)0;
+            pScheduler->Property = COROUTINE_PROP_READY;
+            error = COROUTINE_ERR_NONE;
+        }
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：唤醒协程调度器的宿主线程                                                               *
+ *  参数：(1) pScheduler 协程调度器结构地址                                                      *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：线程、ISR和定时器回调函数在使协程等待的条件满足后调用本函数，使得等待条件的协程        *
+ *        立即重新运行，而不必等到下一个轮询周期                                                 *
+ *************************************************************************************************/
+TState xCoSchedulerWake(TCoScheduler* pScheduler, TError* pError)
+{
+    TState state = eFailure;
+    TError error = COROUTINE_ERR_UNREADY;
+    TError ipcError;
+
+    if (pScheduler->Property & COROUTINE_PROP_READY)
+    {
+        /* 信号量最大值为1，多次唤醒合并成一次，所以信号量已满时同样认为成功 */
+        xSemaphoreRelease(&(pScheduler->Signal), IPC_OPT_DEFAULT, 0U, &ipcError);
+        error = COROUTINE_ERR_NONE;
+        state = eSuccess;
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：在协程调度器中启动一个协程                                                             *
+ *  参数：(1) pScheduler 协程调度器结构地址                                                      *
+ *        (2) pCoroutine 协程结构地址                                                            *
+ *        (3) pEntry     协程函数                                                                *
+ *        (4) data       协程函数参数                                                            *
+ *        (5) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：协程运行结束之后可以再次启动                                                           *
+ *************************************************************************************************/
+TState xCoroutineSpawn(TCoScheduler* pScheduler, TCoroutine* pCoroutine,
+                       TCoroutineEntry pEntry, TArgument data, TError* pError)
+{
+    TState state = eFailure;
+    TError error = COROUTINE_ERR_UNREADY;
+    TError ipcError;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pScheduler->Property & COROUTINE_PROP_READY)
+    {
+        if (!(pCoroutine->Property & COROUTINE_PROP_READY))
+        {
+            pCoroutine->Property = COROUTINE_PROP_READY;
+            pCoroutine->Label = 0U;
+            pCoroutine->WakeTicks = 0U;
+            pCoroutine->Entry = pEntry;
+            pCoroutine->Argument = data;
+            pCoroutine->LinkNode.Next = (TLinkNode*)0;
+            pCoroutine->LinkNode.Prev = (TLinkNode*)0;
+            pCoroutine->LinkNode.Handle = (TLinkNode**)0;
+            pCoroutine->LinkNode.Data = (TBase32*)0;
+            pCoroutine->LinkNode.Owner = (void*)pCoroutine;
+            uObjListAddNode(&(pScheduler->Handle), &(pCoroutine->LinkNode), eLinkPosTail);
+
+            error = COROUTINE_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = COROUTINE_ERR_STATUS;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    /* 唤醒宿主线程运行新的协程 */
+    if (state == eSuccess)
+    {
+        xSemaphoreRelease(&(pScheduler->Signal), IPC_OPT_DEFAULT, 0U, &ipcError);
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：协程调度器主循环                                                                       *
+ *  参数：(1) pScheduler 协程调度器结构地址                                                      *
+ *  返回：无                                                                                     *
+ *  说明：(1) 本函数由宿主线程的线程函数调用，不会返回                                           *
+ *        (2) 每一轮依次运行全部到期的协程；没有协程让出时宿主线程阻塞在信号量上，               *
+ *            直到最近的协程延时到期、轮询周期到达或者被唤醒                                     *
+ *        (3) 轮询周期为0时，等待条件的协程只在调度器被唤醒时才重新运行                          *
+ *************************************************************************************************/
+void xCoSchedulerRun(TCoScheduler* pScheduler)
+{
+    TReg32 imask;
+    TError error;
+    TLinkNode* pNode;
+    TCoroutine* pCoroutine;
+    TCoroutineState state;
+    TTimeTick jiffies;
+    TTimeTick timeo;
+    TBool yielded;
+
+    KNL_ASSERT((pScheduler->Property & COROUTINE_PROP_READY), "");
+
+    while (eTrue)
+    {
+        xKernelGetJiffies(&jiffies);
+        timeo = pScheduler->PollTicks;
+        yielded = eFalse;
+
+        CpuEnterCritical(&imask);
+        pNode = pScheduler->Handle;
+        CpuLeaveCritical(imask);
+
+        while (pNode != (TLinkNode*)0)
+        {
+            pCoroutine = (TCoroutine*)(pNode->Owner);
+
+            if (pCoroutine->WakeTicks <= jiffies)
+            {
+                pCoroutine->WakeTicks = 0U;
+                state = pCoroutine->Entry(pCoroutine, pCoroutine->Argument);
+                if (state == eCoroutineYielded)
+                {
+                    yielded = eTrue;
+                }
+            }
+            else
+            {
+                state = eCoroutineWaiting;
+            }
+
+            /* 计算宿主线程最长的休眠时间 */
+            if ((state == eCoroutineWaiting) && (pCoroutine->WakeTicks > jiffies) &&
+                    ((timeo == 0U) || ((pCoroutine->WakeTicks - jiffies) < timeo)))
+            {
+                timeo = pCoroutine->WakeTicks - jiffies;
+            }
+
+            /* 其它线程可能同时在队列尾部启动新的协程，所以取后继节点和移出节点都要保护 */
+            CpuEnterCritical(&imask);
+            pNode = pNode->Next;
+            if (state == eCoroutineExited)
+            {
+                uObjListRemoveNode(&(pScheduler->Handle), &(pCoroutine->LinkNode));
+                pCoroutine->Property &= ~COROUTINE_PROP_READY;
+            }
+            CpuLeaveCritical(imask);
+        }
+
+        /* 有协程让出时只检查一下唤醒信号，不休眠 */
+        if (yielded == eTrue)
+        {
+            xSemaphoreObtain(&(pScheduler->Signal), IPC_OPT_DEFAULT, 0U, &error);
+        }
+        else
+        {
+            xSemaphoreObtain(&(pScheduler->Signal), IPC_OPT_WAIT | IPC_OPT_TIMEO, timeo, &error);
+        }
+    }
+}
+
+#endif
+
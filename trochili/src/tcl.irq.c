@@ -50,6 +50,11 @@ void xIrqEnterISR(TIndex irqn)
     TISR        pISR;
     TArgument   data;
     TBitMask    retv = IRQ_ISR_DONE;
+#if (TCLC_KERNEL_PROFILE_ENABLE)
+    TBase32     cycles;
+
+    cycles = CpuGetCycleCount();
+#endif
 
     KNL_ASSERT((irqn < TCLC_CPU_IRQ_NUM), "");
     CpuEnterCritical(&imask);
@@ -84,6 +89,11 @@ void xIrqEnterISR(TIndex irqn)
         pVector->Property &= (~IRQ_VECTOR_PROP_LOCKED);
     }
 
+    /* 记录本次中断的执行时间 */
+#if (TCLC_KERNEL_PROFILE_ENABLE)
+    uKernelRecordIsr(irqn, CpuGetCycleCount() - cycles);
+#endif
+
     CpuLeaveCritical(imask);
 }
 
@@ -358,6 +368,7 @@ void uIrqCreateDaemon(void)
                   (void*)IrqDaemonStack,
                   (TBase32)TCLC_IRQ_DAEMON_STACK_BYTES,
                   (TPriority)TCLC_IRQ_DAEMON_PRIORITY,
+                  (TPriority)TCLC_IRQ_DAEMON_PRIORITY,
                   (TTimeTick)TCLC_IRQ_DAEMON_SLICE);
 
     /* 初始化相关的内核变量 */
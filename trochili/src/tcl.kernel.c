@@ -149,12 +149,20 @@ void xKernelLeaveIntrState(void)
 void xKernelTickISR(void)
 {
     TReg32 imask;
+#if (TCLC_KERNEL_PROFILE_ENABLE)
+    TBase32 cycles;
+#endif
 
     CpuEnterCritical(&imask);
 
     /* 内核总运行时间节拍数增加1次 */
     uKernelVariable.Jiffies++;
 
+    /* 在节拍数更新之后开始计时，保证周期计数连续 */
+#if (TCLC_KERNEL_PROFILE_ENABLE)
+    cycles = CpuGetCycleCount();
+#endif
+
     /* 处理线程时钟节拍 */
     uThreadTickUpdate();
 
@@ -166,6 +174,10 @@ void xKernelTickISR(void)
     uTimerTickUpdate();
 #endif
 
+#if (TCLC_KERNEL_PROFILE_ENABLE)
+    uKernelRecordIsr(KERNEL_PROFILE_TICK_ISR, CpuGetCycleCount() - cycles);
+#endif
+
     CpuLeaveCritical(imask);
 }
 
@@ -290,6 +302,40 @@ void xKernelGetJiffies(TTimeTick* pJiffies)
 }
 
 
+/*************************************************************************************************
+ *  功能：获得系统已运行时间戳                                                                   *
+ *  参数：无                                                                                     *
+ *  返回：以微秒为单位的时间戳数值                                                               *
+ *  说明：时间戳由系统节拍数和当前节拍内已经经过的处理器周期数合成，精度高于一个时钟节拍，       *
+ *        本函数需要在临界区中调用                                                               *
+ *************************************************************************************************/
+TTimeStamp uKernelGetTimeStamp(void)
+{
+    TTimeStamp stamp;
+
+    stamp  = (uKernelVariable.Jiffies * 1000U * 1000U) / TCLC_TIME_TICK_RATE;
+    stamp += ((TTimeStamp)CpuGetTickCycles() * 1000U * 1000U) / TCLC_CPU_CLOCK_FREQ;
+
+    return stamp;
+}
+
+
+/*************************************************************************************************
+ *  功能：获得系统已运行时间戳                                                                   *
+ *  参数：(1) pStamp 返回以微秒为单位的时间戳数值                                                *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+void xKernelGetTimeStamp(TTimeStamp* pStamp)
+{
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+    *pStamp = uKernelGetTimeStamp();
+    CpuLeaveCritical(imask);
+}
+
+
 /*************************************************************************************************
  *  功能：内核启动函数                                                                           *
  *  参数：(1) pUserEntry  应用初始化函数                                                         *
@@ -434,6 +480,7 @@ static void CreateRootThread(void)
                   (void*)RootThreadStack,
                   (TBase32)TCLC_ROOT_THREAD_STACK_BYTES,
                   (TPriority)TCLC_ROOT_THREAD_PRIORITY,
+                  (TPriority)TCLC_ROOT_THREAD_PRIORITY,
                   (TTimeTick)TCLC_ROOT_THREAD_SLICE);
 
     /* 初始化相关的内核变量 */
@@ -441,3 +488,159 @@ static void CreateRootThread(void)
     uKernelVariable.NomineeThread = &RootThread;
     uKernelVariable.CurrentThread = &RootThread;
 }
+
+
+#if (TCLC_KERNEL_PROFILE_ENABLE)
+/* 中断执行时间统计表 */
+static TIsrProfile IsrProfileTable[KERNEL_PROFILE_ISR_NUM];
+
+/* 临界区关中断时间统计 */
+static TCriticalProfile CriticalProfile;
+
+/* 当前最外层临界区的起始周期数和调用者地址 */
+static TBase32 CriticalStartCycles;
+static TAddr32 CriticalCaller;
+
+
+/*************************************************************************************************
+ *  功能：记录一次中断服务程序的执行时间                                                         *
+ *  参数：(1) index  中断统计项编号                                                              *
+ *        (2) cycles 本次中断执行时间                                                            *
+ *  返回：无                                                                                     *
+ *  说明：本函数需要在临界区中调用，中断执行时间包含了被更高优先级中断嵌套的时间                 *
+ *************************************************************************************************/
+void uKernelRecordIsr(TIndex index, TBase32 cycles)
+{
+    TIsrProfile* pProfile;
+
+    if (index < KERNEL_PROFILE_ISR_NUM)
+    {
+        pProfile = &(IsrProfileTable[index]);
+        if (pProfile->Times == 0U)
+        {
+            pProfile->MinCycles = cycles;
+            pProfile->MaxCycles = cycles;
+        }
+        else
+        {
+            if (cycles < pProfile->MinCycles)
+            {
+                pProfile->MinCycles = cycles;
+            }
+            if (cycles > pProfile->MaxCycles)
+            {
+                pProfile->MaxCycles = cycles;
+            }
+        }
+        pProfile->Times++;
+        pProfile->TotalCycles += cycles;
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：获得中断执行时间统计数据                                                               *
+ *  参数：(1) index    中断统计项编号                                                            *
+ *        (2) pProfile 返回中断执行时间统计数据                                                  *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：外部中断的统计项编号就是其物理中断号，时钟节拍中断使用KERNEL_PROFILE_TICK_ISR          *
+ *************************************************************************************************/
+TState xKernelGetIsrProfile(TIndex index, TIsrProfile* pProfile)
+{
+    TState state = eFailure;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+    if (index < KERNEL_PROFILE_ISR_NUM)
+    {
+        *pProfile = IsrProfileTable[index];
+        if (pProfile->Times != 0U)
+        {
+            pProfile->AvgCycles = (TBase32)(pProfile->TotalCycles / pProfile->Times);
+        }
+        state = eSuccess;
+    }
+    CpuLeaveCritical(imask);
+
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：获得临界区关中断时间统计数据                                                           *
+ *  参数：(1) pProfile 返回临界区关中断时间统计数据                                              *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+void xKernelGetCriticalProfile(TCriticalProfile* pProfile)
+{
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+    *pProfile = CriticalProfile;
+    CpuLeaveCritical(imask);
+}
+
+
+/*************************************************************************************************
+ *  功能：清除内核性能统计数据                                                                   *
+ *  参数：无                                                                                     *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+void xKernelResetProfile(void)
+{
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+    memset(IsrProfileTable, 0U, sizeof(IsrProfileTable));
+    memset(&CriticalProfile, 0U, sizeof(CriticalProfile));
+    CpuLeaveCritical(imask);
+}
+
+
+/* 以下代码需要调用处理器原始的临界区操作函数 */
+#undef CpuEnterCritical
+#undef CpuLeaveCritical
+
+/*************************************************************************************************
+ *  功能：进入临界区并开始统计关中断时间                                                         *
+ *  参数：(1) pValue 保存进入临界区之前的中断屏蔽状态                                            *
+ *  返回：无                                                                                     *
+ *  说明：只有最外层临界区才开始计时，嵌套的临界区不影响统计结果                                 *
+ *************************************************************************************************/
+void xKernelEnterCritical(TReg32* pValue)
+{
+    CpuEnterCritical(pValue);
+    if (*pValue == 0U)
+    {
+        CriticalStartCycles = CpuGetCycleCount();
+        CriticalCaller      = CpuGetCallerAddr();
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：退出临界区并更新关中断时间统计                                                         *
+ *  参数：(1) value 进入临界区之前的中断屏蔽状态                                                 *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+void xKernelLeaveCritical(TReg32 value)
+{
+    TBase32 cycles;
+
+    if (value == 0U)
+    {
+        cycles = CpuGetCycleCount() - CriticalStartCycles;
+        CriticalProfile.Times++;
+        if (cycles > CriticalProfile.MaxCycles)
+        {
+            CriticalProfile.MaxCycles = cycles;
+            CriticalProfile.MaxCaller = CriticalCaller;
+        }
+    }
+    CpuLeaveCritical(value);
+}
+#endif
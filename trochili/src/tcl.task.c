@@ -0,0 +1,219 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#include <string.h>
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.cpu.h"
+#include "tcl.debug.h"
+#include "tcl.kernel.h"
+#include "tcl.thread.h"
+#include "tcl.task.h"
+
+#if (TCLC_TASK_ENABLE)
+
+/* 宿主线程不接受任何线程管理API操作，任务函数中的阻塞、延时和让出操作都会失败 */
+#define TASK_LEVEL_ACAPI (THREAD_ACAPI_NONE)
+
+
+/*************************************************************************************************
+ *  功能：任务级别宿主线程的线程函数                                                             *
+ *  参数：(1) argument 任务级别结构地址                                                          *
+ *  返回：无                                                                                     *
+ *  说明：按照优先级逐个运行被激活的任务，同优先级的任务按照激活的先后顺序运行，                 *
+ *        没有被激活的任务时宿主线程将自己挂起                                                   *
+ *************************************************************************************************/
+static void xTaskLevelEntry(TArgument argument)
+{
+    TReg32      imask;
+    TTaskLevel* pLevel = (TTaskLevel*)argument;
+    TTask*      pTask;
+    TTaskEntry  pEntry;
+    TArgument   data;
+
+    while(eTrue)
+    {
+        CpuEnterCritical(&imask);
+        if (pLevel->Handle == (TLinkNode*)0)
+        {
+            uThreadSuspendSelf();
+            CpuLeaveCritical(imask);
+        }
+        else
+        {
+            /* 任务在运行前消耗一次激活，运行期间再次被激活的任务会重新进入激活队列 */
+            pTask  = (TTask*)(pLevel->Handle->Owner);
+            pEntry = pTask->Entry;
+            data   = pTask->Argument;
+            pTask->Activations--;
+            if (pTask->Activations == 0U)
+            {
+                uObjListRemoveNode(pTask->LinkNode.Handle, &(pTask->LinkNode));
+            }
+            CpuLeaveCritical(imask);
+
+            pEntry(data);
+        }
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：初始化任务级别                                                                         *
+ *  参数：(1) pLevel     任务级别结构地址                                                        *
+ *        (2) pName      任务级别名称                                                            *
+ *        (3) pStack     该级别全部任务共用的线程栈地址                                          *
+ *        (4) bytes      线程栈大小，以字节为单位                                                *
+ *        (5) priority   宿主线程优先级                                                          *
+ *        (6) ticks      宿主线程时间片长度                                                      *
+ *        (7) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：线程栈的大小只需要满足该级别中用栈最深的那个任务函数                                   *
+ *************************************************************************************************/
+TState xTaskLevelCreate(TTaskLevel* pLevel, TChar* pName, void* pStack, TBase32 bytes,
+                        TPriority priority, TTimeTick ticks, TError* pError)
+{
+    TState state = eFailure;
+    TError error = TASK_ERR_FAULT;
+    TError thrError;
+
+    if (!(pLevel->Property & TASK_PROP_READY))
+    {
+        pLevel->Handle = (TLinkNode*)0;
+        state = xThreadCreate(&(pLevel->Thread),
+                              pName,
+                              eThreadSuspended,
+                              THREAD_PROP_PRIORITY_FIXED,
+                              TASK_LEVEL_ACAPI,
+                              xTaskLevelEntry,
+                              (TArgument)pLevel,
+                              pStack,
+                              bytes,
+                              priority,
+                              priority,
+                              ticks,
+                              &thrError);
+        if (state == eSuccess)
+        {
+            pLevel->Property = TASK_PROP_READY;
+            error = TASK_ERR_NONE;
+        }
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：初始化运行到完成任务                                                                   *
+ *  参数：(1) pTask       任务结构地址                                                           *
+ *        (2) pLevel      任务所属的任务级别                                                     *
+ *        (3) pEntry      任务函数                                                               *
+ *        (4) data        任务函数参数                                                           *
+ *        (5) priority    任务在级别内的优先级                                                   *
+ *        (6) activations 任务允许挂起的最大激活次数                                             *
+ *        (7) pError      详细调用结果                                                           *
+ *  返回：(1) eSuccess    操作成功                                                               *
+ *        (2) eFailure    操作失败                                                               *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xTaskCreate(TTask* pTask, TTaskLevel* pLevel, TTaskEntry pEntry, TArgument data,
+                   TPriority priority, TBase32 activations, TError* pError)
+{
+    TState state = eFailure;
+    TError error = TASK_ERR_UNREADY;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pLevel->Property & TASK_PROP_READY)
+    {
+        if (!(pTask->Property & TASK_PROP_READY))
+        {
+            pTask->Property        = TASK_PROP_READY;
+            pTask->Priority        = priority;
+            pTask->Activations     = 0U;
+            pTask->MaxActivations  = activations;
+            pTask->Entry           = pEntry;
+            pTask->Argument        = data;
+            pTask->Level           = pLevel;
+            pTask->LinkNode.Next   = (TLinkNode*)0;
+            pTask->LinkNode.Prev   = (TLinkNode*)0;
+            pTask->LinkNode.Handle = (TLinkNode**)0;
+            pTask->LinkNode.Data   = (TBase32*)(&(pTask->Priority));
+            pTask->LinkNode.Owner  = (void*)pTask;
+
+            error = TASK_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = TASK_ERR_FAULT;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：激活运行到完成任务                                                                     *
+ *  参数：(1) pTask      任务结构地址                                                            *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：(1) 线程和ISR都可以调用本函数                                                          *
+ *        (2) 任务在运行或者等待运行时再次被激活，只记录激活次数，任务函数会被多运行一次         *
+ *************************************************************************************************/
+TState xTaskActivate(TTask* pTask, TError* pError)
+{
+    TState state = eFailure;
+    TError error = TASK_ERR_UNREADY;
+    TTaskLevel* pLevel;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pTask->Property & TASK_PROP_READY)
+    {
+        if (pTask->Activations < pTask->MaxActivations)
+        {
+            pLevel = pTask->Level;
+            pTask->Activations++;
+            if (pTask->Activations == 1U)
+            {
+                uObjListAddPriorityNode(&(pLevel->Handle), &(pTask->LinkNode));
+            }
+
+            /* 唤醒宿主线程，在线程环境下立即尝试调度，在中断环境下留到退出中断时调度 */
+            uThreadResumeFromISR(&(pLevel->Thread));
+            if ((uKernelVariable.State == eThreadState) &&
+                    (uKernelVariable.SchedLockTimes == 0U))
+            {
+                uThreadSchedule();
+            }
+
+            error = TASK_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = TASK_ERR_LIMIT;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+#endif
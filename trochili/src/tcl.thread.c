@@ -21,6 +21,214 @@ static TThreadQueue ThreadReadyQueue;
 /* 内核线程辅助队列定义，处于延时、挂起、休眠的线程都放在这个队列里 */
 static TThreadQueue ThreadAuxiliaryQueue;
 
+#if (TCLC_THREAD_EDF_ENABLE)
+/* 判断线程是否按照截止期调度，EDF优先级只保留给EDF线程，被预算限制的EDF线程按照普通线程调度 */
+#define THREAD_IS_EDF(THREAD) \
+    (((THREAD)->Property & THREAD_PROP_EDF) && ((THREAD)->Priority == TCLC_THREAD_EDF_PRIORITY))
+
+/* EDF就绪线程堆，堆顶是截止期最早的就绪EDF线程 */
+static TThread* EdfReadyHeap[TCLC_THREAD_EDF_THREAD_NUM];
+static TBase32  EdfReadyNum;
+
+/* 内核中EDF线程的数目 */
+static TBase32  EdfThreadNum;
+#else
+#define THREAD_IS_EDF(THREAD) (0)
+#endif
+
+#if (TCLC_THREAD_BUDGET_ENABLE)
+/* 正在等待CPU预算补充的线程队列，按照补充时刻排序 */
+static TLinkNode* ThreadBudgetList;
+
+/* 判断线程是否因为CPU预算耗尽而被降低了优先级 */
+#define THREAD_IS_DEMOTED(THREAD) \
+    (((THREAD)->Property & THREAD_PROP_THROTTLED) && \
+     (!((THREAD)->BudgetOption & THREAD_BUDGET_SUSPEND)))
+
+/* 判断线程是否因为CPU预算耗尽而被挂起 */
+#define THREAD_IS_BUDGET_SUSPENDED(THREAD) \
+    (((THREAD)->Property & THREAD_PROP_THROTTLED) && \
+     ((THREAD)->BudgetOption & THREAD_BUDGET_SUSPEND))
+#endif
+
+#if (TCLC_THREAD_CYCLE_ENABLE)
+/* 正在被统计运行时间的线程、上次采样时的处理器周期计数和全部线程总的运行周期数 */
+static TThread*   CycleThread;
+static TBase32    CycleStamp;
+static TTimeStamp CycleTotal;
+#endif
+
+
+#if (TCLC_THREAD_EDF_ENABLE)
+/*************************************************************************************************
+ *  功能：将EDF线程在就绪截止期堆中向堆顶方向调整                                                *
+ *  参数：(1) index   线程在堆中的位置                                                           *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+static void MoveEdfThreadUp(TIndex index)
+{
+    TThread* pThread = EdfReadyHeap[index];
+    TIndex parent;
+
+    while (index > 0U)
+    {
+        parent = (index - 1U) >> 1;
+        if (EdfReadyHeap[parent]->Deadline <= pThread->Deadline)
+        {
+            break;
+        }
+        EdfReadyHeap[index] = EdfReadyHeap[parent];
+        EdfReadyHeap[index]->EdfIndex = index;
+        index = parent;
+    }
+
+    EdfReadyHeap[index] = pThread;
+    pThread->EdfIndex = index;
+}
+
+
+/*************************************************************************************************
+ *  功能：将EDF线程在就绪截止期堆中向堆底方向调整                                                *
+ *  参数：(1) index   线程在堆中的位置                                                           *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+static void MoveEdfThreadDown(TIndex index)
+{
+    TThread* pThread = EdfReadyHeap[index];
+    TIndex child = (index << 1) + 1U;
+
+    while (child < EdfReadyNum)
+    {
+        if (((child + 1U) < EdfReadyNum) &&
+                (EdfReadyHeap[child + 1U]->Deadline < EdfReadyHeap[child]->Deadline))
+        {
+            child++;
+        }
+        if (pThread->Deadline <= EdfReadyHeap[child]->Deadline)
+        {
+            break;
+        }
+        EdfReadyHeap[index] = EdfReadyHeap[child];
+        EdfReadyHeap[index]->EdfIndex = index;
+        index = child;
+        child = (index << 1) + 1U;
+    }
+
+    EdfReadyHeap[index] = pThread;
+    pThread->EdfIndex = index;
+}
+
+
+/*************************************************************************************************
+ *  功能：EDF线程截止期改变后调整它在就绪截止期堆中的位置                                        *
+ *  参数：(1) pThread 线程结构地址                                                               *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+static void UpdateEdfThread(TThread* pThread)
+{
+    MoveEdfThreadUp(pThread->EdfIndex);
+    MoveEdfThreadDown(pThread->EdfIndex);
+}
+
+
+/*************************************************************************************************
+ *  功能：将EDF线程加入就绪截止期堆                                                              *
+ *  参数：(1) pThread 线程结构地址                                                               *
+ *  返回：无                                                                                     *
+ *  说明：堆的容量等于内核允许的EDF线程数目，所以不会溢出                                        *
+ *************************************************************************************************/
+static void AddEdfThread(TThread* pThread)
+{
+    KNL_ASSERT((EdfReadyNum < TCLC_THREAD_EDF_THREAD_NUM), "");
+
+    EdfReadyHeap[EdfReadyNum] = pThread;
+    pThread->EdfIndex = EdfReadyNum;
+    EdfReadyNum++;
+    MoveEdfThreadUp(pThread->EdfIndex);
+}
+
+
+/*************************************************************************************************
+ *  功能：将EDF线程移出就绪截止期堆                                                              *
+ *  参数：(1) pThread 线程结构地址                                                               *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+static void RemoveEdfThread(TThread* pThread)
+{
+    TIndex index = pThread->EdfIndex;
+    TThread* pLast;
+
+    EdfReadyNum--;
+    if (index != EdfReadyNum)
+    {
+        /* 用堆尾的线程填补空位，再调整它的位置 */
+        pLast = EdfReadyHeap[EdfReadyNum];
+        EdfReadyHeap[index] = pLast;
+        pLast->EdfIndex = index;
+        UpdateEdfThread(pLast);
+    }
+    EdfReadyHeap[EdfReadyNum] = (TThread*)0;
+}
+
+
+/*************************************************************************************************
+ *  功能：检查就绪截止期堆中的EDF线程是否错过截止期                                              *
+ *  参数：无                                                                                     *
+ *  返回：无                                                                                     *
+ *  说明：(1) 当前运行的EDF线程也在堆中，等待被调度的EDF线程同样会被记录，每个截止期只记录一次   *
+ *        (2) 堆顶线程的截止期最早，如果它还没有到期则不必检查其它线程                           *
+ *************************************************************************************************/
+static void CheckEdfDeadlines(void)
+{
+    TIndex   index;
+    TThread* pThread;
+
+    if ((EdfReadyNum > 0U) && (uKernelVariable.Jiffies > EdfReadyHeap[0]->Deadline))
+    {
+        for (index = 0U; index < EdfReadyNum; index++)
+        {
+            pThread = EdfReadyHeap[index];
+            if ((uKernelVariable.Jiffies > pThread->Deadline) &&
+                    (!(pThread->Diagnosis & THREAD_DIAG_DEADLINE_MISS)))
+            {
+                pThread->Diagnosis |= THREAD_DIAG_DEADLINE_MISS;
+                pThread->DeadlineMisses++;
+            }
+        }
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：避免普通线程使用EDF线程保留的优先级                                                    *
+ *  参数：(1) pThread  线程结构地址                                                              *
+ *        (2) priority 线程的目标优先级                                                          *
+ *  返回：线程实际可以使用的优先级                                                               *
+ *  说明：互斥量天花板、优先级继承或者CPU预算限制要求普通线程使用EDF优先级时，沿着优先级变化的   *
+ *        方向越过EDF优先级，提升优先级时不会低于要求的优先级，降低优先级时不会高于要求的优先级  *
+ *************************************************************************************************/
+static TPriority SkipEdfPriority(TThread* pThread, TPriority priority)
+{
+    if ((priority == TCLC_THREAD_EDF_PRIORITY) && (!(pThread->Property & THREAD_PROP_EDF)))
+    {
+        if (((priority < pThread->Priority) && (priority > 0U)) ||
+                (priority == TCLC_LOWEST_PRIORITY))
+        {
+            priority--;
+        }
+        else
+        {
+            priority++;
+        }
+    }
+    return priority;
+}
+#endif
+
 
 /*************************************************************************************************
  *  功能：将线程从指定的状态转换到就绪态，使得线程能够参与内核调度                               *
@@ -46,7 +254,7 @@ static TState SetThreadReady(TThread* pThread, TThreadStatus status, TBool* pHiR
         uThreadLeaveQueue(&ThreadAuxiliaryQueue, pThread);
         uThreadEnterQueue(&ThreadReadyQueue, pThread, eLinkPosTail);
         pThread->Status = eThreadReady;
-        if (pThread->Priority < uKernelVariable.CurrentThread->Priority)
+        if (uThreadCheckPreempt(pThread) == eTrue)
         {
             *pHiRP = eTrue;
         }
@@ -145,6 +353,164 @@ static void CalcThreadHiRP(TPriority* priority)
 }
 
 
+#if (TCLC_THREAD_BUDGET_ENABLE)
+/*************************************************************************************************
+ *  功能：限制CPU预算耗尽的线程                                                                  *
+ *  参数：(1) pThread  线程结构地址                                                              *
+ *  返回：无                                                                                     *
+ *  说明：占有互斥量的线程暂不限制，以免阻碍等待该互斥量的线程，释放互斥量后的下一个节拍再限制   *
+ *************************************************************************************************/
+static void ThrottleThread(TThread* pThread)
+{
+    TBool HiRP = eFalse;
+    TError error;
+
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_MUTEX_ENABLE))
+    if (pThread->LockList != (TLinkNode*)0)
+    {
+        /* 等待线程释放全部互斥量 */
+    }
+    else
+#endif
+    if (pThread->BudgetOption & THREAD_BUDGET_SUSPEND)
+    {
+        /*
+         * 当前线程可能刚被时间片轮转而处于就绪状态，但仍在就绪队列中；
+         * 如果内核此时禁止线程调度，那么当前线程不能被挂起，等到下一个节拍再处理
+         */
+        if (((pThread->Status == eThreadRunning) || (pThread->Status == eThreadReady)) &&
+                (uKernelVariable.SchedLockTimes == 0U))
+        {
+            uThreadLeaveQueue(&ThreadReadyQueue, pThread);
+            uThreadEnterQueue(&ThreadAuxiliaryQueue, pThread, eLinkPosTail);
+            pThread->Status = eThreadSuspended;
+            pThread->Property |= THREAD_PROP_THROTTLED;
+        }
+    }
+    else
+    {
+        uThreadSetPriority(pThread, pThread->BudgetPriority, eFalse, &HiRP, &error);
+        pThread->Property |= THREAD_PROP_THROTTLED;
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：解除对线程的CPU预算限制                                                                *
+ *  参数：(1) pThread  线程结构地址                                                              *
+ *  返回：(1) eTrue    有更高优先级的线程就绪
+ *        (2) eFalse   没有更高优先级的线程就绪
+ *  说明：被降低优先级的线程恢复到基本优先级，被挂起并且没有同时被用户挂起的线程恢复就绪         *
+ *************************************************************************************************/
+static TBool UnthrottleThread(TThread* pThread)
+{
+    TBool HiRP = eFalse;
+    TError error;
+
+    pThread->Property &= ~THREAD_PROP_THROTTLED;
+    if (pThread->BudgetOption & THREAD_BUDGET_SUSPEND)
+    {
+        /* 线程在被限制期间又被用户挂起，那么仍然保持挂起，等待用户解挂 */
+        if ((pThread->Status == eThreadSuspended) &&
+                (!(pThread->Property & THREAD_PROP_USER_SUSPENDED)))
+        {
+            uThreadResumeFromISR(pThread);
+            HiRP = uThreadCheckPreempt(pThread);
+        }
+    }
+    else
+    {
+        /* 线程在被限制期间可能因为互斥量天花板而获得了更高的优先级 */
+        if (pThread->Priority > pThread->BasePriority)
+        {
+            uThreadSetPriority(pThread, pThread->BasePriority, eFalse, &HiRP, &error);
+        }
+    }
+
+    return HiRP;
+}
+
+
+/*************************************************************************************************
+ *  功能：线程CPU预算节拍处理函数                                                                *
+ *  参数：(1) pThread  当前线程                                                                  *
+ *  返回：无                                                                                     *
+ *  说明：线程从满额预算开始消耗时开始计算补充周期，补充周期到达时一次补满预算                   *
+ *************************************************************************************************/
+static void UpdateThreadBudget(TThread* pThread)
+{
+    TThread* pOwner;
+
+    /* 扣除当前线程的CPU预算，从满额预算开始消耗时进入补充队列 */
+    if (pThread->BudgetTicks != 0U)
+    {
+        if (pThread->BudgetRemain == pThread->BudgetTicks)
+        {
+            pThread->BudgetStamp = uKernelVariable.Jiffies + pThread->BudgetPeriod;
+            uObjListAddPriorityNode(&ThreadBudgetList, &(pThread->BudgetNode));
+        }
+
+        if (pThread->BudgetRemain > 0U)
+        {
+            pThread->BudgetRemain--;
+        }
+
+        if ((pThread->BudgetRemain == 0U) && (!(pThread->Property & THREAD_PROP_THROTTLED)))
+        {
+            ThrottleThread(pThread);
+        }
+    }
+
+    /*
+     * 补充到达补充时刻的线程的CPU预算，队列按补充时刻排序，只需检查队列头；
+     * 时钟节拍中断退出时总会进行线程调度，所以这里不必记录是否有更高优先级线程就绪
+     */
+    while (ThreadBudgetList != (TLinkNode*)0)
+    {
+        pOwner = (TThread*)(ThreadBudgetList->Owner);
+        if (uKernelVariable.Jiffies < pOwner->BudgetStamp)
+        {
+            break;
+        }
+
+        uObjListRemoveNode(&ThreadBudgetList, &(pOwner->BudgetNode));
+        pOwner->BudgetRemain = pOwner->BudgetTicks;
+        if (pOwner->Property & THREAD_PROP_THROTTLED)
+        {
+            UnthrottleThread(pOwner);
+        }
+    }
+}
+#endif
+
+
+#if (TCLC_THREAD_CYCLE_ENABLE)
+/*************************************************************************************************
+ *  功能：采样处理器周期计数器，把上次采样以来的周期数记到正在被统计的线程上                     *
+ *  参数：(1) pThread 此后被统计运行时间的线程                                                   *
+ *  返回：无                                                                                     *
+ *  说明：(1) 在临界区或者中断中调用，中断服务程序的执行时间记在被中断的线程上                   *
+ *        (2) 周期计数器只有32位，时钟节拍中断里的采样保证两次采样之间计数器不会回绕两次         *
+ *************************************************************************************************/
+static void UpdateThreadCycles(TThread* pThread)
+{
+    TBase32 stamp;
+    TBase32 cycles;
+
+    stamp = CpuGetCycleCount();
+    cycles = stamp - CycleStamp;
+    CycleStamp = stamp;
+
+    if (CycleThread != (TThread*)0)
+    {
+        CycleThread->RunCycles += cycles;
+        CycleTotal += cycles;
+    }
+    CycleThread = pThread;
+}
+#endif
+
+
 #if (TCLC_THREAD_STACK_CHECK_ENABLE)
 /*************************************************************************************************
  *  功能：告警和检查线程栈溢出问题                                                               *
@@ -209,6 +575,19 @@ void uThreadModuleInit(void)
 
     memset(&ThreadReadyQueue, 0, sizeof(ThreadReadyQueue));
     memset(&ThreadAuxiliaryQueue, 0, sizeof(ThreadAuxiliaryQueue));
+#if (TCLC_THREAD_BUDGET_ENABLE)
+    ThreadBudgetList = (TLinkNode*)0;
+#endif
+#if (TCLC_THREAD_CYCLE_ENABLE)
+    CycleThread = (TThread*)0;
+    CycleStamp = 0U;
+    CycleTotal = 0U;
+#endif
+#if (TCLC_THREAD_EDF_ENABLE)
+    memset(EdfReadyHeap, 0, sizeof(EdfReadyHeap));
+    EdfReadyNum = 0U;
+    EdfThreadNum = 0U;
+#endif
 
     uKernelVariable.ThreadReadyQueue = &ThreadReadyQueue;
     uKernelVariable.ThreadAuxiliaryQueue = &ThreadAuxiliaryQueue;
@@ -242,6 +621,14 @@ void uThreadEnterQueue(TThreadQueue* pQueue, TThread* pThread, TLinkPos pos)
     priority = pThread->Priority;
     pHandle = &(pQueue->Handle[priority]);
 
+#if (TCLC_THREAD_EDF_ENABLE)
+    /* 就绪的EDF线程同时加入截止期堆 */
+    if ((pQueue == &ThreadReadyQueue) && THREAD_IS_EDF(pThread))
+    {
+        AddEdfThread(pThread);
+    }
+#endif
+
     /* 将线程加入指定的分队列 */
     uObjQueueAddFifoNode(pHandle, &(pThread->LinkNode), pos);
 
@@ -276,6 +663,13 @@ void uThreadLeaveQueue(TThreadQueue* pQueue, TThread* pThread)
     /* 将线程从指定的分队列中取出 */
     uObjQueueRemoveNode(pHandle, &(pThread->LinkNode));
 
+#if (TCLC_THREAD_EDF_ENABLE)
+    if ((pQueue == &ThreadReadyQueue) && THREAD_IS_EDF(pThread))
+    {
+        RemoveEdfThread(pThread);
+    }
+#endif
+
     /* 设置线程所属队列 */
     pThread->Queue = (TThreadQueue*)0;
 
@@ -311,15 +705,25 @@ void uThreadTickUpdate(void)
     pThread->Ticks--;
     pThread->Jiffies++;
 
+#if (TCLC_THREAD_CYCLE_ENABLE)
+    /* 每个节拍采样一次周期计数器，统计线程在本节拍内的准确运行时间 */
+    UpdateThreadCycles(CycleThread);
+#endif
+
+#if (TCLC_THREAD_EDF_ENABLE)
+    /* 检查全部就绪EDF线程是否错过截止期 */
+    CheckEdfDeadlines();
+#endif
+
     /* 如果本轮时间片运行完毕 */
     if (pThread->Ticks == 0U)
     {
         /* 恢复线程的时钟节拍数 */
         pThread->Ticks = pThread->BaseTicks;
 
-        /* 判断线程是不是处于内核就绪线程队列的某个优先级的队列头 */
+        /* 判断线程是不是处于内核就绪线程队列的某个优先级的队列头，EDF线程不参与时间片轮转 */
         pHandle = ThreadReadyQueue.Handle[pThread->Priority];
-        if ((TThread*)(pHandle->Owner) == pThread)
+        if (((TThread*)(pHandle->Owner) == pThread) && (!THREAD_IS_EDF(pThread)))
         {
             /* 如果内核此时允许线程调度 */
             if (uKernelVariable.SchedLockTimes == 0U)
@@ -336,6 +740,11 @@ void uThreadTickUpdate(void)
             }
         }
     }
+
+    /* 处理线程CPU预算的扣除和补充 */
+#if (TCLC_THREAD_BUDGET_ENABLE)
+    UpdateThreadBudget(pThread);
+#endif
 }
 
 
@@ -446,6 +855,28 @@ void uThreadSchedule(void)
     /* 查找最高就绪优先级，获得后继线程，如果后继线程指针为空则说明内核发生致命错误 */
     CalcThreadHiRP(&priority);
     uKernelVariable.NomineeThread = (TThread*)((ThreadReadyQueue.Handle[priority])->Owner);
+
+#if (TCLC_THREAD_EDF_ENABLE)
+    /* 如果EDF优先级是最高就绪优先级，则选择截止期最早的EDF线程 */
+    if (THREAD_IS_EDF(uKernelVariable.NomineeThread))
+    {
+        uKernelVariable.NomineeThread = EdfReadyHeap[0];
+    }
+#endif
+
+    /*
+     * 如果当前线程仍在运行(没有让出处理器，也没有被时间片轮转)，那么更高优先级的
+     * 线程只有在优先级也高于当前线程抢占阈值的时候才能抢占它；同优先级线程之间的
+     * 选择不受抢占阈值影响
+     */
+    if ((uKernelVariable.CurrentThread->Status == eThreadRunning) &&
+            (uKernelVariable.CurrentThread->Queue == &ThreadReadyQueue) &&
+            (priority < uKernelVariable.CurrentThread->Priority) &&
+            (priority >= uKernelVariable.CurrentThread->Threshold))
+    {
+        uKernelVariable.NomineeThread = uKernelVariable.CurrentThread;
+    }
+
     if (uKernelVariable.NomineeThread == (TThread*)0)
     {
         uDebugPanic("", __FILE__, __FUNCTION__, __LINE__);
@@ -479,6 +910,14 @@ void uThreadSchedule(void)
          */
         uKernelVariable.CurrentThread->Status = eThreadRunning;
     }
+
+#if (TCLC_THREAD_CYCLE_ENABLE)
+    /* 从此刻开始统计后继线程的运行时间 */
+    if (uKernelVariable.NomineeThread != CycleThread)
+    {
+        UpdateThreadCycles(uKernelVariable.NomineeThread);
+    }
+#endif
 }
 
 
@@ -493,14 +932,16 @@ void uThreadSchedule(void)
  *        (7)  pStack   线程栈地址                                                               *
  *        (8)  bytes    线程栈大小，以字为单位                                                   *
  *        (9)  priority 线程优先级                                                               *
- *        (10) ticks    线程时间片长度                                                           *
+ *        (10) threshold 线程抢占阈值                                                            *
+ *        (11) ticks    线程时间片长度                                                           *
  *  返回：(1)  eFailure                                                                          *
  *        (2)  eSuccess                                                                          *
  *  说明：注意栈起始地址、栈大小和栈告警地址的字节对齐问题                                       *
  *************************************************************************************************/
 void uThreadCreate(TThread* pThread, TChar* pName, TThreadStatus status, TProperty property,
                    TBitMask acapi, TThreadEntry pEntry, TArgument argument,
-                   void* pStack, TBase32 bytes, TPriority priority, TTimeTick ticks)
+                   void* pStack, TBase32 bytes, TPriority priority, TPriority threshold,
+                   TTimeTick ticks)
 {
     TThreadQueue* pQueue;
 
@@ -535,11 +976,43 @@ void uThreadCreate(TThread* pThread, TChar* pName, TThreadStatus status, TProper
     pThread->Ticks = ticks;
     pThread->BaseTicks = ticks;
     pThread->Jiffies = 0U;
+#if (TCLC_THREAD_CYCLE_ENABLE)
+    pThread->RunCycles = 0U;
+#endif
+
+    /* 设置EDF线程截止期，截止期未设置之前EDF线程在EDF优先级里最后运行 */
+#if (TCLC_THREAD_EDF_ENABLE)
+    pThread->Deadline = TCLM_MAX_VALUE64;
+    pThread->DeadlineMisses = 0U;
+    pThread->EdfIndex = 0U;
+    if (property & THREAD_PROP_EDF)
+    {
+        EdfThreadNum++;
+    }
+#endif
+
+    /* 线程初始没有CPU预算限制 */
+#if (TCLC_THREAD_BUDGET_ENABLE)
+    pThread->BudgetTicks = 0U;
+    pThread->BudgetRemain = 0U;
+    pThread->BudgetPeriod = 0U;
+    pThread->BudgetStamp = 0U;
+    pThread->BudgetOption = THREAD_BUDGET_DEMOTE;
+    pThread->BudgetPriority = priority;
+    pThread->BudgetNode.Owner = (void*)pThread;
+    pThread->BudgetNode.Data = (TBase32*)(&(pThread->BudgetStamp));
+    pThread->BudgetNode.Prev = (TLinkNode*)0;
+    pThread->BudgetNode.Next = (TLinkNode*)0;
+    pThread->BudgetNode.Handle = (TLinkNode**)0;
+#endif
 
     /* 设置线程优先级 */
     pThread->Priority = priority;
     pThread->BasePriority = priority;
 
+    /* 设置线程抢占阈值，阈值不能低于线程优先级 */
+    pThread->Threshold = (threshold < priority) ? threshold : priority;
+
     /* 设置线程入口函数和线程参数 */
     pThread->Entry = pEntry;
     pThread->Argument = argument;
@@ -582,7 +1055,8 @@ void uThreadCreate(TThread* pThread, TChar* pName, TThreadStatus status, TProper
     pThread->LinkNode.Next = (TLinkNode*)0;
     pThread->LinkNode.Handle = (TLinkNode**)0;
 
-    /* 将线程加入内核线程队列，设置线程状态 */
+    /* 将线程加入内核线程队列，设置线程状态，线程属性决定了线程是否加入EDF就绪堆 */
+    pThread->Property = property;
     pQueue = (status == eThreadReady) ? (&ThreadReadyQueue): (&ThreadAuxiliaryQueue);
     uThreadEnterQueue(pQueue, pThread, eLinkPosTail);
     pThread->Status = status;
@@ -618,6 +1092,18 @@ TState uThreadDelete(TThread* pThread, TError* pError)
         {
             uKernelRemoveObject(&(pThread->Object));
             uThreadLeaveQueue(pThread->Queue, pThread);
+#if (TCLC_THREAD_EDF_ENABLE)
+            if (pThread->Property & THREAD_PROP_EDF)
+            {
+                EdfThreadNum--;
+            }
+#endif
+#if (TCLC_THREAD_BUDGET_ENABLE)
+            if (pThread->BudgetNode.Handle != (TLinkNode**)0)
+            {
+                uObjListRemoveNode(&ThreadBudgetList, &(pThread->BudgetNode));
+            }
+#endif
             memset(pThread, 0, sizeof(pThread));
             error = THREAD_ERR_NONE;
             state = eSuccess;
@@ -637,7 +1123,8 @@ TState uThreadDelete(TThread* pThread, TError* pError)
  *        (4) pError   保存操作结果                                                              *
  *  返回：(1) eFailure 更改线程优先级失败                                                        *
  *        (2) eSuccess 更改线程优先级成功                                                        *
- *  说明：如果是临时修改优先级，则不修改线程结构的基本优先级                                     *
+ *  说明：(1) 如果是临时修改优先级，则不修改线程结构的基本优先级                                 *
+ *        (2) 普通线程不会被设置到EDF优先级，而是越过它使用相邻的优先级                          *
  *************************************************************************************************/
 TState uThreadSetPriority(TThread* pThread, TPriority priority, TBool flag, TBool* pHiRP, TError* pError)
 {
@@ -645,6 +1132,11 @@ TState uThreadSetPriority(TThread* pThread, TPriority priority, TBool flag, TBoo
     TError error = THREAD_ERR_PRIORITY;
     TPriority newPrio;
 
+#if (TCLC_THREAD_EDF_ENABLE)
+    /* EDF优先级只保留给EDF线程使用 */
+    priority = SkipEdfPriority(pThread, priority);
+#endif
+
     if (pThread->Priority != priority)
     {
         if (pThread->Status == eThreadBlocked)
@@ -727,6 +1219,57 @@ TState uThreadSetPriority(TThread* pThread, TPriority priority, TBool flag, TBoo
 }
 
 
+/*************************************************************************************************
+ *  功能：获得线程在不占有互斥量时应该使用的优先级                                               *
+ *  参数：(1) pThread  线程结构地址                                                              *
+ *  返回：线程的基本优先级，或者CPU预算耗尽时线程被降低到的后台优先级                            *
+ *  说明：互斥量恢复线程优先级时使用本函数，避免线程借助互斥量逃脱CPU预算限制                    *
+ *************************************************************************************************/
+TPriority uThreadGetBasePriority(TThread* pThread)
+{
+    TPriority priority = pThread->BasePriority;
+
+#if (TCLC_THREAD_BUDGET_ENABLE)
+    if (THREAD_IS_DEMOTED(pThread) && (pThread->BudgetPriority > priority))
+    {
+        priority = pThread->BudgetPriority;
+    }
+#endif
+
+    return priority;
+}
+
+
+/*************************************************************************************************
+ *  功能：判断新就绪的线程是否应该抢占当前线程                                                   *
+ *  参数：(1) pThread   线程结构地址                                                             *
+ *  返回：(1) eTrue     需要抢占当前线程                                                         *
+ *        (2) eFalse    不需要抢占当前线程                                                       *
+ *  说明：(1) 线程的优先级必须高于当前线程的抢占阈值                                             *
+ *        (2) 同在EDF优先级上的两个EDF线程，截止期更早的线程可以抢占                             *
+ *************************************************************************************************/
+TBool uThreadCheckPreempt(TThread* pThread)
+{
+    TBool HiRP = eFalse;
+    TThread* pCurrent = uKernelVariable.CurrentThread;
+
+    /* 只有优先级高于当前线程抢占阈值的线程才能抢占当前线程 */
+    if ((pThread->Priority < pCurrent->Priority) && (pThread->Priority < pCurrent->Threshold))
+    {
+        HiRP = eTrue;
+    }
+#if (TCLC_THREAD_EDF_ENABLE)
+    else if (THREAD_IS_EDF(pThread) && THREAD_IS_EDF(pCurrent) &&
+             (pThread->Deadline < pCurrent->Deadline))
+    {
+        HiRP = eTrue;
+    }
+#endif
+
+    return HiRP;
+}
+
+
 /*************************************************************************************************
  *  功能：将线程从挂起状态转换到就绪态，使得线程能够参与内核调度                                 *
  *  参数：(1) pThread   线程结构地址                                                             *
@@ -797,16 +1340,17 @@ void uThreadSuspendSelf(void)
  *        (7)  pStack   线程栈地址                                                               *
  *        (8)  bytes    线程栈大小，以字为单位                                                   *
  *        (9)  priority 线程优先级                                                               *
- *        (10) ticks    线程时间片长度                                                           *
- *        (11) pError   详细调用结果                                                             *
+ *        (10) threshold 线程抢占阈值                                                            *
+ *        (11) ticks    线程时间片长度                                                           *
+ *        (12) pError   详细调用结果                                                             *
  *  返回：(1)  eFailure                                                                          *
  *        (2)  eSuccess                                                                          *
  *  说明：函数名的前缀'x'(eXtreme)表示本函数需要处理临界区代码                                   *
  *************************************************************************************************/
 TState xThreadCreate(TThread* pThread, TChar* pName, TThreadStatus status, TProperty property,
                      TBitMask acapi, TThreadEntry pEntry, TArgument argument,
-                     void* pStack, TBase32 bytes, TPriority priority, TTimeTick ticks,
-                     TError* pError)
+                     void* pStack, TBase32 bytes, TPriority priority, TPriority threshold,
+                     TTimeTick ticks, TError* pError)
 {
     TState state = eFailure;
     TError error = THREAD_ERR_FAULT;
@@ -820,12 +1364,28 @@ TState xThreadCreate(TThread* pThread, TChar* pName, TThreadStatus status, TProp
         /* 检查线程是否已经被初始化 */
         if (!(pThread->Property &THREAD_PROP_READY))
         {
-            uThreadCreate(pThread, pName, status, property,
-                          acapi, pEntry, argument,
-                          pStack, bytes,
-                          priority, ticks);
-            error = THREAD_ERR_NONE;
-            state = eSuccess;
+#if (TCLC_THREAD_EDF_ENABLE)
+            /* 使用EDF优先级的线程按照截止期调度，它的优先级不能被修改 */
+            if (priority == TCLC_THREAD_EDF_PRIORITY)
+            {
+                property |= (THREAD_PROP_EDF | THREAD_PROP_PRIORITY_FIXED);
+            }
+
+            /* EDF线程数目不能超过EDF就绪堆的容量 */
+            if ((property & THREAD_PROP_EDF) && (EdfThreadNum >= TCLC_THREAD_EDF_THREAD_NUM))
+            {
+                error = THREAD_ERR_FAULT;
+            }
+            else
+#endif
+            {
+                uThreadCreate(pThread, pName, status, property,
+                              acapi, pEntry, argument,
+                              pStack, bytes,
+                              priority, threshold, ticks);
+                error = THREAD_ERR_NONE;
+                state = eSuccess;
+            }
         }
     }
 
@@ -896,6 +1456,8 @@ TState xThreadDelete(TThread* pThread, TError* pError)
  *        (2) eSuccess 更改线程优先级成功                                                        *
  *  说明：(1) 如果是临时修改优先级，则不修改线程结构的基本优先级数据                             *
  *        (2) 互斥量实施优先级继承协议的时候不受AUTHORITY控制                                    *
+ *        (3) 使能EDF调度时，EDF优先级只保留给EDF线程                                            *
+ *        (4) CPU预算耗尽而被降低优先级的线程，新的优先级在预算补充之后才生效                    *
  *************************************************************************************************/
 TState xThreadSetPriority(TThread* pThread, TPriority priority, TError* pError)
 {
@@ -924,11 +1486,106 @@ TState xThreadSetPriority(TThread* pThread, TPriority priority, TError* pError)
                 if ((!(pThread->Property & THREAD_PROP_PRIORITY_FIXED)) &&
                         (pThread->Property & THREAD_PROP_PRIORITY_SAFE))
                 {
-                    state = uThreadSetPriority(pThread, priority, eTrue, &HiRP, &error);
-                    if ((uKernelVariable.SchedLockTimes == 0U) && (HiRP == eTrue))
+#if (TCLC_THREAD_EDF_ENABLE)
+                    /* EDF优先级只保留给EDF线程，普通线程不能被设置到这个优先级 */
+                    if (priority == TCLC_THREAD_EDF_PRIORITY)
+                    {
+                        error = THREAD_ERR_PRIORITY;
+                    }
+                    else
+#endif
+#if (TCLC_THREAD_BUDGET_ENABLE)
+                    /* 被降低优先级的线程只记录新的基本优先级，预算补充之后再使用 */
+                    if (THREAD_IS_DEMOTED(pThread))
+                    {
+                        pThread->BasePriority = priority;
+                        priority = uThreadGetBasePriority(pThread);
+                        state = eSuccess;
+                        error = THREAD_ERR_NONE;
+                        if (priority != pThread->Priority)
+                        {
+                            state = uThreadSetPriority(pThread, priority, eFalse, &HiRP, &error);
+                        }
+                        if ((uKernelVariable.SchedLockTimes == 0U) && (HiRP == eTrue))
+                        {
+                            uThreadSchedule();
+                        }
+                    }
+                    else
+#endif
+                    {
+                        state = uThreadSetPriority(pThread, priority, eTrue, &HiRP, &error);
+                        if ((uKernelVariable.SchedLockTimes == 0U) && (HiRP == eTrue))
+                        {
+                            uThreadSchedule();
+                        }
+                    }
+                }
+                else
+                {
+                    error = THREAD_ERR_PRIORITY;
+                }
+            }
+            else
+            {
+                error = THREAD_ERR_ACAPI;
+            }
+        }
+        else
+        {
+            error = THREAD_ERR_UNREADY;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+    *pError = error;
+    return state;
+
+}
+
+
+/*************************************************************************************************
+ *  功能：更改线程抢占阈值                                                                       *
+ *  参数：(1) pThread   线程结构地址                                                             *
+ *        (2) threshold 线程抢占阈值                                                             *
+ *        (3) pError    详细调用结果                                                             *
+ *  返回：(1) eFailure  更改线程抢占阈值失败                                                     *
+ *        (2) eSuccess  更改线程抢占阈值成功                                                     *
+ *  说明：抢占阈值不能低于线程的基本优先级，降低当前线程的抢占阈值可能立即引起线程抢占           *
+ *************************************************************************************************/
+TState xThreadSetThreshold(TThread* pThread, TPriority threshold, TError* pError)
+{
+    TState state = eFailure;
+    TError error = THREAD_ERR_FAULT;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    /* 只允许在线程代码里调用本函数 */
+    if (uKernelVariable.State == eThreadState)
+    {
+        /* 如果没有给出被操作的线程地址，则强制使用当前线程 */
+        if (pThread == (TThread*)0)
+        {
+            pThread = uKernelVariable.CurrentThread;
+        }
+
+        /* 检查线程是否已经被初始化 */
+        if (pThread->Property &THREAD_PROP_READY)
+        {
+            /* 检查线程是否接收相关API调用 */
+            if (pThread->ACAPI &THREAD_ACAPI_PRIORITY)
+            {
+                if (threshold <= pThread->BasePriority)
+                {
+                    pThread->Threshold = threshold;
+                    if ((pThread == uKernelVariable.CurrentThread) &&
+                            (uKernelVariable.SchedLockTimes == 0U))
                     {
                         uThreadSchedule();
                     }
+                    error = THREAD_ERR_NONE;
+                    state = eSuccess;
                 }
                 else
                 {
@@ -949,8 +1606,59 @@ TState xThreadSetPriority(TThread* pThread, TPriority priority, TError* pError)
     CpuLeaveCritical(imask);
     *pError = error;
     return state;
+}
+
+
+#if (TCLC_THREAD_CYCLE_ENABLE)
+/*************************************************************************************************
+ *  功能：获得线程运行时间统计数据                                                               *
+ *  参数：(1) pThread  线程结构地址                                                              *
+ *        (2) pStats   返回线程运行时间统计数据                                                  *
+ *        (3) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess                                                                           *
+ *        (2) eFailure                                                                           *
+ *  说明：统计数据从内核启动开始累计，用户可以比较前后两次的结果计算一段时间内的负载             *
+ *************************************************************************************************/
+TState xThreadGetStats(TThread* pThread, TThreadStats* pStats, TError* pError)
+{
+    TState state = eFailure;
+    TError error = THREAD_ERR_UNREADY;
+    TReg32 imask;
 
+    CpuEnterCritical(&imask);
+
+    /* 如果没有给出被操作的线程地址，则强制使用当前线程 */
+    if (pThread == (TThread*)0)
+    {
+        pThread = uKernelVariable.CurrentThread;
+    }
+
+    /* 检查线程是否已经被初始化 */
+    if (pThread->Property &THREAD_PROP_READY)
+    {
+        /* 先把当前线程尚未记账的运行时间记上 */
+        UpdateThreadCycles(CycleThread);
+
+        pStats->RunCycles = pThread->RunCycles;
+        pStats->TotalCycles = CycleTotal;
+        pStats->Load = 0U;
+        pStats->IdleLoad = 0U;
+        if (CycleTotal != 0U)
+        {
+            pStats->Load = (TBase32)((pThread->RunCycles * 1000U) / CycleTotal);
+            pStats->IdleLoad = (TBase32)((uKernelVariable.RootThread->RunCycles * 1000U) /
+                                         CycleTotal);
+        }
+        error = THREAD_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
 }
+#endif
 
 
 /*************************************************************************************************
@@ -1018,6 +1726,161 @@ TState xThreadSetTimeSlice(TThread* pThread, TTimeTick ticks, TError* pError)
 
 
 
+#if (TCLC_THREAD_EDF_ENABLE)
+/*************************************************************************************************
+ *  功能：设置EDF线程的截止期                                                                    *
+ *  参数：(1) pThread 线程结构地址                                                               *
+ *        (2) ticks   从现在开始到截止期的时钟节拍数                                             *
+ *        (3) pError  详细调用结果                                                               *
+ *  返回：(1) eSuccess                                                                           *
+ *        (2) eFailure                                                                           *
+ *  说明：周期性EDF线程通常在每个周期开始时设置新的截止期，同时清除错过截止期的诊断标记          *
+ *************************************************************************************************/
+TState xThreadSetDeadline(TThread* pThread, TTimeTick ticks, TError* pError)
+{
+    TState state = eFailure;
+    TError error = THREAD_ERR_FAULT;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    /* 只允许在线程代码里调用本函数 */
+    if (uKernelVariable.State == eThreadState)
+    {
+        /* 如果没有给出被操作的线程地址，则强制使用当前线程 */
+        if (pThread == (TThread*)0)
+        {
+            pThread = uKernelVariable.CurrentThread;
+        }
+
+        /* 检查线程是否已经被初始化 */
+        if (pThread->Property &THREAD_PROP_READY)
+        {
+            /* 检查线程是否接收相关API调用 */
+            if (pThread->ACAPI &THREAD_ACAPI_DEADLINE)
+            {
+                /* 只有EDF线程才有截止期 */
+                if (pThread->Property & THREAD_PROP_EDF)
+                {
+                    pThread->Deadline = uKernelVariable.Jiffies + ticks;
+                    pThread->Diagnosis &= ~THREAD_DIAG_DEADLINE_MISS;
+
+                    /* 如果线程处于EDF就绪堆中，截止期的变化可能导致线程调度 */
+                    if ((pThread->Queue == &ThreadReadyQueue) && THREAD_IS_EDF(pThread))
+                    {
+                        UpdateEdfThread(pThread);
+                        if (uKernelVariable.SchedLockTimes == 0U)
+                        {
+                            uThreadSchedule();
+                        }
+                    }
+
+                    error = THREAD_ERR_NONE;
+                    state = eSuccess;
+                }
+            }
+            else
+            {
+                error = THREAD_ERR_ACAPI;
+            }
+        }
+        else
+        {
+            error = THREAD_ERR_UNREADY;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+#endif
+
+
+#if (TCLC_THREAD_BUDGET_ENABLE)
+/*************************************************************************************************
+ *  功能：设置线程的CPU预算                                                                      *
+ *  参数：(1) pThread  线程结构地址                                                              *
+ *        (2) budget   每个补充周期内线程可以运行的时钟节拍数，为0时取消CPU预算限制              *
+ *        (3) period   CPU预算的补充周期                                                         *
+ *        (4) option   CPU预算耗尽时的处理方式                                                   *
+ *        (5) priority CPU预算耗尽时线程被降低到的后台优先级                                     *
+ *        (6) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess                                                                           *
+ *        (2) eFailure                                                                           *
+ *  说明：重新设置CPU预算时线程的预算被补满，已经被限制的线程恢复运行                            *
+ *************************************************************************************************/
+TState xThreadSetBudget(TThread* pThread, TTimeTick budget, TTimeTick period,
+                        TOption option, TPriority priority, TError* pError)
+{
+    TState state = eFailure;
+    TError error = THREAD_ERR_FAULT;
+    TBool HiRP = eFalse;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    /* 只允许在线程代码里调用本函数 */
+    if (uKernelVariable.State == eThreadState)
+    {
+        /* 如果没有给出被操作的线程地址，则强制使用当前线程 */
+        if (pThread == (TThread*)0)
+        {
+            pThread = uKernelVariable.CurrentThread;
+        }
+
+        /* 检查线程是否已经被初始化 */
+        if (pThread->Property &THREAD_PROP_READY)
+        {
+            /* 检查线程是否接收相关API调用 */
+            if (pThread->ACAPI &THREAD_ACAPI_BUDGET)
+            {
+                /* 解除线程当前的CPU预算限制 */
+                if (pThread->Property & THREAD_PROP_THROTTLED)
+                {
+                    HiRP = UnthrottleThread(pThread);
+                }
+
+                pThread->BudgetTicks = budget;
+                pThread->BudgetRemain = budget;
+                pThread->BudgetPeriod = period;
+                pThread->BudgetOption = option;
+                pThread->BudgetPriority = priority;
+
+                /* 预算已经补满，线程不再等待补充 */
+                if (pThread->BudgetNode.Handle != (TLinkNode**)0)
+                {
+                    uObjListRemoveNode(&ThreadBudgetList, &(pThread->BudgetNode));
+                }
+
+                if ((uKernelVariable.SchedLockTimes == 0U) && (HiRP == eTrue))
+                {
+                    uThreadSchedule();
+                }
+
+                error = THREAD_ERR_NONE;
+                state = eSuccess;
+            }
+            else
+            {
+                error = THREAD_ERR_ACAPI;
+            }
+        }
+        else
+        {
+            error = THREAD_ERR_UNREADY;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+#endif
+
+
 /*************************************************************************************************
  *  功能：线程级线程调度函数，当前线程主动让出处理器(保持就绪状态)                               *
  *  参数：(1) pError    详细调用结果                                                             *
@@ -1192,6 +2055,7 @@ TState xThreadActivate(TThread* pThread, TError* pError)
  *  返回：(1) eFailure                                                                           *
  *        (2) eSuccess                                                                           *
  *  说明：(1) 内核初始化线程不能被挂起                                                           *
+ *        (2) 因为CPU预算耗尽而被挂起的线程，在预算补充之后仍然保持用户挂起状态                  *
  *************************************************************************************************/
 TState xThreadSuspend(TThread* pThread, TError* pError)
 {
@@ -1217,10 +2081,27 @@ TState xThreadSuspend(TThread* pThread, TError* pError)
             /* 检查线程是否接收相关API调用 */
             if (pThread->ACAPI &THREAD_ACAPI_SUSPEND)
             {
-                state = SetThreadUnready(pThread, eThreadSuspended, 0U, &HiRP, &error);
-                if (HiRP == eTrue)
+#if (TCLC_THREAD_BUDGET_ENABLE)
+                /* 已经因为CPU预算耗尽而被挂起的线程，只需要记录用户的挂起操作 */
+                if (THREAD_IS_BUDGET_SUSPENDED(pThread) &&
+                        (!(pThread->Property & THREAD_PROP_USER_SUSPENDED)))
                 {
-                    uThreadSchedule();
+                    pThread->Property |= THREAD_PROP_USER_SUSPENDED;
+                    error = THREAD_ERR_NONE;
+                    state = eSuccess;
+                }
+                else
+#endif
+                {
+                    state = SetThreadUnready(pThread, eThreadSuspended, 0U, &HiRP, &error);
+                    if (state == eSuccess)
+                    {
+                        pThread->Property |= THREAD_PROP_USER_SUSPENDED;
+                    }
+                    if (HiRP == eTrue)
+                    {
+                        uThreadSchedule();
+                    }
                 }
             }
             else
@@ -1247,7 +2128,7 @@ TState xThreadSuspend(TThread* pThread, TError* pError)
  *        (2) pError  详细调用结果                                                               *
  *  返回：(1) eFailure                                                                           *
  *        (2) eSuccess                                                                           *
- *  说明：                                                                                       *
+ *  说明：因为CPU预算耗尽而被挂起的线程不会提前恢复，预算补充之后才恢复就绪                      *
  *************************************************************************************************/
 TState xThreadResume(TThread* pThread, TError* pError)
 {
@@ -1267,10 +2148,26 @@ TState xThreadResume(TThread* pThread, TError* pError)
             /* 检查线程是否接收相关API调用 */
             if (pThread->ACAPI &THREAD_ACAPI_RESUME)
             {
-                state = SetThreadReady(pThread, eThreadSuspended, &HiRP, &error);
-                if ((uKernelVariable.SchedLockTimes == 0U) && (HiRP == eTrue))
+#if (TCLC_THREAD_BUDGET_ENABLE)
+                /* 因为CPU预算耗尽而被挂起的线程只撤销用户的挂起操作，等到预算补充之后才恢复就绪 */
+                if (THREAD_IS_BUDGET_SUSPENDED(pThread))
                 {
-                    uThreadSchedule();
+                    pThread->Property &= ~THREAD_PROP_USER_SUSPENDED;
+                    error = THREAD_ERR_NONE;
+                    state = eSuccess;
+                }
+                else
+#endif
+                {
+                    state = SetThreadReady(pThread, eThreadSuspended, &HiRP, &error);
+                    if (state == eSuccess)
+                    {
+                        pThread->Property &= ~THREAD_PROP_USER_SUSPENDED;
+                    }
+                    if ((uKernelVariable.SchedLockTimes == 0U) && (HiRP == eTrue))
+                    {
+                        uThreadSchedule();
+                    }
                 }
             }
             else
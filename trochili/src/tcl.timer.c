@@ -23,6 +23,54 @@
  */
 static TTimerList TimerList;
 
+/* 定时器守护线程一次批处理的期满定时器信息 */
+typedef struct
+{
+    TTimer*       Timer;
+    TBase32       Generation;
+    TTimeTick     Ticks;
+} TTimerBatchItem;
+
+/* 定时器配置版本号发生器，定时器被创建、停止或者重新配置时取得新的版本号 */
+static TBase32 TimerGeneration = 0U;
+
+/* 定时器守护线程批处理缓冲区，只由定时器守护线程使用 */
+static TTimerBatchItem  TimerBatch[TCLC_TIMER_DAEMON_BATCH];
+
+/* 定时器守护线程批处理统计数据 */
+static TTimerBatchStats TimerBatchStats;
+
+
+/*************************************************************************************************
+ *  功能：在定时器允许的延缓范围内选择到时时刻                                                   *
+ *  参数：(1) ticks 定时器不考虑延缓时的到时时刻                                                 *
+ *        (2) slack 定时器允许延缓的节拍数                                                       *
+ *  返回：定时器实际的到时时刻                                                                   *
+ *  说明：在[ticks, ticks + slack]范围内选择低位0最多的节拍，这样具有延缓属性的定时器会对齐到    *
+ *        相同的节拍上到时，减少定时器守护线程被唤醒的次数                                       *
+ *************************************************************************************************/
+static TTimeTick ApplyTimerSlack(TTimeTick ticks, TTimeTick slack)
+{
+    TTimeTick limit;
+    TTimeTick mask;
+
+    if (slack == 0U)
+    {
+        return ticks;
+    }
+
+    /* 找到到时范围上下限之间最高的不同位，把上限中低于该位的部分清零 */
+    limit = ticks + slack;
+    mask  = ticks ^ limit;
+    while (mask & (mask - 1U))
+    {
+        mask &= (mask - 1U);
+    }
+    limit &= ~(mask - 1U);
+
+    return limit;
+}
+
 
 /*************************************************************************************************
  *  功能：定时器执行处理函数                                                                     *
@@ -43,10 +91,18 @@ static void DispatchExpiredTimer(TTimer* pTimer)
     /*
      * 将定时器放入内核定时器期满列表，
      * 最后由定时器守护线程处理。紧急的定时器优先处理;
+     * 中断型定时器放入中断期满列表，在本次时钟节拍中断中处理
      */
     if (!(pTimer->Property & TIMER_PROP_EXPIRED))
     {
-        uObjListAddPriorityNode(&(TimerList.ExpiredHandle), &(pTimer->ExpiredNode));
+        if (pTimer->Property & TIMER_PROP_ISR)
+        {
+            uObjListAddPriorityNode(&(TimerList.IsrExpiredHandle), &(pTimer->ExpiredNode));
+        }
+        else
+        {
+            uObjListAddPriorityNode(&(TimerList.ExpiredHandle), &(pTimer->ExpiredNode));
+        }
         pTimer->ExpiredTicks = pTimer->MatchTicks;
         pTimer->Property |= TIMER_PROP_EXPIRED;
     }
@@ -58,7 +114,8 @@ static void DispatchExpiredTimer(TTimer* pTimer)
     if (pTimer->Property & TIMER_PROP_PERIODIC)
     {
       	pTimer->ExpiredTimes++;
-        pTimer->MatchTicks += pTimer->PeriodTicks;
+        pTimer->DueTicks  += pTimer->PeriodTicks;
+        pTimer->MatchTicks = ApplyTimerSlack(pTimer->DueTicks, pTimer->SlackTicks);
         spoke = (TBase32)(pTimer->MatchTicks % TCLC_TIMER_WHEEL_SIZE);
         uObjListAddPriorityNode(&(TimerList.ActiveHandle[spoke]), &(pTimer->LinkNode));
         pTimer->Status = eTimerActive;
@@ -121,6 +178,18 @@ void uTimerTickUpdate(void)
         }
     }
 
+    /*
+     * 在中断环境下逐个执行中断型定时器的回调函数。
+     * 回调函数可能启动或者停止其它定时器，所以每次都从中断期满列表头部取定时器
+     */
+    while (TimerList.IsrExpiredHandle != (TLinkNode*)0)
+    {
+        pTimer = (TTimer*)(TimerList.IsrExpiredHandle->Owner);
+        uObjListRemoveNode(pTimer->ExpiredNode.Handle, &(pTimer->ExpiredNode));
+        pTimer->Property &= ~TIMER_PROP_EXPIRED;
+        pTimer->Routine(pTimer->Argument, 0U);
+    }
+
     /* 如果需要则唤醒内核内置的用户定时器守护线程 */
     if (TimerList.ExpiredHandle != (TLinkNode*)0)
     {
@@ -162,12 +231,15 @@ TState xTimerCreate(TTimer* pTimer, TChar* pName, TProperty property, TTimeTick
         pTimer->Status       = eTimerDormant;
         pTimer->Property     = (property | TIMER_PROP_READY);
         pTimer->PeriodTicks  = ticks;
+        pTimer->SlackTicks   = (TTimeTick)0;
+        pTimer->DueTicks     = (TTimeTick)0;
         pTimer->MatchTicks   = (TTimeTick)0;
         pTimer->Routine      = pRoutine;
         pTimer->Argument     = data;
         pTimer->Priority     = priority;
         pTimer->ExpiredTicks = (TTimeTick)0;
   	    pTimer->ExpiredTimes = 0U;
+        pTimer->Generation   = ++TimerGeneration;
 		
         /* 设置定时器期满链表节点信息 */
         pTimer->ExpiredNode.Next   = (TLinkNode*)0;
@@ -268,7 +340,8 @@ TState xTimerStart(TTimer* pTimer,TTimeTick lagticks, TError* pError)
             uObjListRemoveNode(pTimer->LinkNode.Handle, &(pTimer->LinkNode));
 
             /* 将定时器加入活动队列里 */
-            pTimer->MatchTicks  = uKernelVariable.Jiffies + pTimer->PeriodTicks + lagticks;
+            pTimer->DueTicks    = uKernelVariable.Jiffies + pTimer->PeriodTicks + lagticks;
+            pTimer->MatchTicks  = ApplyTimerSlack(pTimer->DueTicks, pTimer->SlackTicks);
             spoke = (TBase32)(pTimer->MatchTicks % TCLC_TIMER_WHEEL_SIZE);
             uObjListAddPriorityNode(&(TimerList.ActiveHandle[spoke]), &(pTimer->LinkNode));
             pTimer->Status = eTimerActive;
@@ -320,6 +393,7 @@ TState xTimerStop(TTimer* pTimer, TError* pError)
             uObjListRemoveNode(pTimer->LinkNode.Handle, &(pTimer->LinkNode));
             uObjListAddNode(&(TimerList.DormantHandle), &(pTimer->LinkNode), eLinkPosHead);
             pTimer->Status = eTimerDormant;
+            pTimer->Generation = ++TimerGeneration;
 
             error = TIMER_ERR_NONE;
             state = eSuccess;
@@ -343,12 +417,14 @@ TState xTimerStop(TTimer* pTimer, TError* pError)
  *  参数：(1) pTimer   定时器结构地址                                                            *
  *        (2) ticks    定时器时钟节拍数目                                                        *
  *        (3) priority 定时器优先级                                                              *
- *        (4) pError   详细调用结果                                                              *
+ *        (4) slack    定时器允许延缓到时的节拍数目                                              *
+ *        (5) pError   详细调用结果                                                              *
  *  返回: (1) eSuccess 操作成功                                                                  *
  *        (2) eFailure 操作失败                                                                  *
  *  说明                                                                                         *
  *************************************************************************************************/
-TState xTimerConfig(TTimer* pTimer, TTimeTick ticks, TPriority priority, TError* pError)
+TState xTimerConfig(TTimer* pTimer, TTimeTick ticks, TPriority priority, TTimeTick slack,
+                    TError* pError)
 {
     TState state = eFailure;
     TError error = TIMER_ERR_UNREADY;
@@ -363,6 +439,218 @@ TState xTimerConfig(TTimer* pTimer, TTimeTick ticks, TPriority priority, TError*
         {
             pTimer->PeriodTicks = ticks;
             pTimer->Priority    = priority;
+            pTimer->SlackTicks  = slack;
+            pTimer->Generation  = ++TimerGeneration;
+            error = TIMER_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = TIMER_ERR_STATUS;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+#if (TCLC_TIMER_HRES_ENABLE)
+/*************************************************************************************************
+ *  功能：将高精度定时器按照到时时刻加入高精度定时器队列                                         *
+ *  参数：(1) pTimer 高精度定时器                                                                *
+ *  返回：无                                                                                     *
+ *  说明：到时时刻相同的定时器按照先来后到排列                                                   *
+ *************************************************************************************************/
+static void AddHresTimer(THrTimer* pTimer)
+{
+    TLinkNode* pCursor = TimerList.HresHandle;
+    TLinkNode* pTail   = (TLinkNode*)0;
+    TLinkNode* pNode   = &(pTimer->LinkNode);
+
+    while ((pCursor != (TLinkNode*)0) &&
+            (((THrTimer*)(pCursor->Owner))->MatchStamp <= pTimer->MatchStamp))
+    {
+        pTail   = pCursor;
+        pCursor = pCursor->Next;
+    }
+
+    if (pTail == (TLinkNode*)0)
+    {
+        uObjListAddNode(&(TimerList.HresHandle), pNode, eLinkPosHead);
+    }
+    else
+    {
+        pNode->Prev = pTail;
+        pNode->Next = pTail->Next;
+        if (pTail->Next != (TLinkNode*)0)
+        {
+            pTail->Next->Prev = pNode;
+        }
+        pTail->Next   = pNode;
+        pNode->Handle = &(TimerList.HresHandle);
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：按照队首高精度定时器的到时时刻启动硬件闹钟                                             *
+ *  参数：无                                                                                     *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+static void ArmHresAlarm(void)
+{
+    THrTimer*  pTimer;
+    TTimeStamp stamp;
+    TTimeStamp usecs = 0U;
+
+    if (TimerList.HresHandle == (TLinkNode*)0)
+    {
+        CpuStopHrAlarm();
+    }
+    else
+    {
+        pTimer = (THrTimer*)(TimerList.HresHandle->Owner);
+        stamp  = uKernelGetTimeStamp();
+        if (pTimer->MatchStamp > stamp)
+        {
+            usecs = pTimer->MatchStamp - stamp;
+            usecs = (usecs > TCLM_MAX_VALUE32) ? TCLM_MAX_VALUE32 : usecs;
+        }
+        CpuStartHrAlarm((TBase32)usecs);
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：初始化高精度单次定时器                                                                 *
+ *  参数：(1) pTimer   高精度定时器结构地址                                                      *
+ *        (2) pRoutine 定时器回调函数                                                            *
+ *        (3) data     定时器回调函数参数                                                        *
+ *        (4) pError   详细调用结果                                                              *
+ *  返回: (1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：定时器结构可以位于栈或者堆中，内容不必预先清零；已经启动的定时器不能再次初始化         *
+ *************************************************************************************************/
+TState xTimerInitHres(THrTimer* pTimer, THrTimerRoutine pRoutine, TArgument data,
+                      TError* pError)
+{
+    TState state = eFailure;
+    TError error = TIMER_ERR_STATUS;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    /* 只有确实挂在高精度定时器队列中的定时器才被认为处于启动状态 */
+    if (!((pTimer->Property & TIMER_PROP_READY) &&
+            (pTimer->Status == eTimerActive) &&
+            (pTimer->LinkNode.Handle == &(TimerList.HresHandle))))
+    {
+        pTimer->Property        = TIMER_PROP_READY;
+        pTimer->Status          = eTimerDormant;
+        pTimer->MatchStamp      = (TTimeStamp)0;
+        pTimer->Routine         = pRoutine;
+        pTimer->Argument        = data;
+        pTimer->LinkNode.Next   = (TLinkNode*)0;
+        pTimer->LinkNode.Prev   = (TLinkNode*)0;
+        pTimer->LinkNode.Handle = (TLinkNode**)0;
+        pTimer->LinkNode.Data   = (TBase32*)0;
+        pTimer->LinkNode.Owner  = (void*)pTimer;
+
+        error = TIMER_ERR_NONE;
+        state = eSuccess;
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：启动高精度单次定时器                                                                   *
+ *  参数：(1) pTimer   高精度定时器结构地址                                                      *
+ *        (2) usecs    定时器到时的微秒数                                                        *
+ *        (3) pError   详细调用结果                                                              *
+ *  返回: (1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xTimerStartHres(THrTimer* pTimer, TTimeStamp usecs, TError* pError)
+{
+    TState state = eFailure;
+    TError error = TIMER_ERR_UNREADY;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    /* 检查定时器就绪属性 */
+    if (pTimer->Property & TIMER_PROP_READY)
+    {
+        if (pTimer->Status == eTimerDormant)
+        {
+            pTimer->MatchStamp = uKernelGetTimeStamp() + usecs;
+            AddHresTimer(pTimer);
+            pTimer->Status = eTimerActive;
+
+            /* 如果新定时器成为最早到时的定时器，则需要重新启动硬件闹钟 */
+            if (TimerList.HresHandle == &(pTimer->LinkNode))
+            {
+                ArmHresAlarm();
+            }
+
+            error = TIMER_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = TIMER_ERR_STATUS;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：停止高精度单次定时器                                                                   *
+ *  参数：(1) pTimer   高精度定时器结构地址                                                      *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回: (1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xTimerStopHres(THrTimer* pTimer, TError* pError)
+{
+    TState state = eFailure;
+    TError error = TIMER_ERR_UNREADY;
+    TReg32 imask;
+    TBool  head;
+
+    CpuEnterCritical(&imask);
+
+    /* 检查定时器就绪属性 */
+    if (pTimer->Property & TIMER_PROP_READY)
+    {
+        if (pTimer->Status == eTimerActive)
+        {
+            head = (TimerList.HresHandle == &(pTimer->LinkNode)) ? eTrue : eFalse;
+            uObjListRemoveNode(pTimer->LinkNode.Handle, &(pTimer->LinkNode));
+            pTimer->Status = eTimerDormant;
+
+            /* 如果停止的是最早到时的定时器，则需要重新启动硬件闹钟 */
+            if (head == eTrue)
+            {
+                ArmHresAlarm();
+            }
+
             error = TIMER_ERR_NONE;
             state = eSuccess;
         }
@@ -379,6 +667,58 @@ TState xTimerConfig(TTimer* pTimer, TTimeTick ticks, TPriority priority, TError*
 }
 
 
+/*************************************************************************************************
+ *  功能：高精度定时器硬件闹钟中断处理函数                                                       *
+ *  参数：无                                                                                     *
+ *  返回：无                                                                                     *
+ *  说明：在中断环境下执行所有已经到时的高精度定时器的回调函数，然后按照下一个定时器重新启动     *
+ *        硬件闹钟。回调函数中可以重新启动高精度定时器                                           *
+ *************************************************************************************************/
+void xTimerHresISR(void)
+{
+    TReg32     imask;
+    THrTimer*  pTimer;
+    TTimeStamp stamp;
+
+    CpuEnterCritical(&imask);
+
+    stamp = uKernelGetTimeStamp();
+    while (TimerList.HresHandle != (TLinkNode*)0)
+    {
+        pTimer = (THrTimer*)(TimerList.HresHandle->Owner);
+        if (pTimer->MatchStamp > stamp)
+        {
+            break;
+        }
+
+        uObjListRemoveNode(pTimer->LinkNode.Handle, &(pTimer->LinkNode));
+        pTimer->Status = eTimerDormant;
+        pTimer->Routine(pTimer->Argument);
+        stamp = uKernelGetTimeStamp();
+    }
+    ArmHresAlarm();
+
+    CpuLeaveCritical(imask);
+}
+#endif
+
+
+/*************************************************************************************************
+ *  功能：获得定时器守护线程批处理统计数据                                                       *
+ *  参数：(1) pStats   返回批处理统计数据                                                        *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+void xTimerGetBatchStats(TTimerBatchStats* pStats)
+{
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+    *pStats = TimerBatchStats;
+    CpuLeaveCritical(imask);
+}
+
+
 /* 内核定时器守护线程定义和栈定义 */
 static TBase32 TimerDaemonStack[TCLC_TIMER_DAEMON_STACK_BYTES >> 2];
 static TThread TimerDaemonThread;
@@ -390,7 +730,7 @@ static TThread TimerDaemonThread;
  *  功能：内核中的定时器守护线程函数                                                             *
  *  参数：(1) argument 定时器线程的用户参数                                                      *
  *  返回：无                                                                                     *
- *  说明：                                                                                       *
+ *  说明：每次在一个临界区内从期满队列中摘下一批定时器，然后在临界区外逐个执行回调函数           *
  *************************************************************************************************/
 static void xTimerDaemonEntry(TArgument argument)
 {
@@ -399,9 +739,12 @@ static void xTimerDaemonEntry(TArgument argument)
     TTimerRoutine pRoutine;
     TArgument     data;
     TTimeTick     ticks;
+    TTimeTick     jiffies;
+    TBase32       number;
+    TIndex        index;
 
     /*
-     * 逐个处理用户定时器，在线程环境下处理定时器回调事务
+     * 成批处理用户定时器，在线程环境下处理定时器回调事务
      * 如果期满定时器队列为空则将定时器守护线程挂起
      */
     while(eTrue)
@@ -415,48 +758,102 @@ static void xTimerDaemonEntry(TArgument argument)
         }
         else
         {
-            /* 从期满队列中取得一个定时器 */
-            pTimer = (TTimer*)(TimerList.ExpiredHandle->Owner);
+            /* 从期满队列头部逐个摘下定时器，期满队列按照优先级排序，所以无需再次排序 */
+            number = 0U;
+            jiffies = uKernelVariable.Jiffies;
+            while ((TimerList.ExpiredHandle != (TLinkNode*)0) &&
+                    (number < TCLC_TIMER_DAEMON_BATCH))
+            {
+                pTimer = (TTimer*)(TimerList.ExpiredHandle->Owner);
+
+                /*
+                 * 计算定时器的漂移时间,如果精准定时器的漂移时间大于等于定时周期，
+                 * 说明定时器被耽搁的实在太长了~,一定是哪里有问题。
+                 */
+                if (jiffies == pTimer->ExpiredTicks)
+                {
+                    ticks = 0U;
+                }
+                else if (jiffies > pTimer->ExpiredTicks)
+                {
+                    ticks = jiffies - pTimer->ExpiredTicks;
+                }
+                else
+                {
+                    ticks = TCLM_MAX_VALUE64 - pTimer->ExpiredTicks + jiffies;
+                }
+
+                if (pTimer->Property & TIMER_PROP_ACCURATE)
+                {
+                    if (ticks >= pTimer->PeriodTicks)
+                    {
+                        uKernelVariable.Diagnosis |= KERNEL_DIAG_TIMER_ERROR;
+                        pTimer->Diagnosis |= TIMER_DIAG_OVERFLOW;
+                        uDebugAlarm("");
+                    }
+                }
+
+                /* 将定时器从期满队列中移出 */
+                uObjListRemoveNode(pTimer->ExpiredNode.Handle, &(pTimer->ExpiredNode));
+                pTimer->Property &= ~TIMER_PROP_EXPIRED;
+
+                /* 记录定时器和它当前的配置版本号，回调函数在执行前再取 */
+                TimerBatch[number].Timer      = pTimer;
+                TimerBatch[number].Generation = pTimer->Generation;
+                TimerBatch[number].Ticks      = ticks;
+                number++;
+            }
+
+            CpuLeaveCritical(imask);
 
             /*
-             * 计算定时器的漂移时间,如果精准定时器的漂移时间大于等于定时周期，
-             * 说明定时器被耽搁的实在太长了~,一定是哪里有问题。
+             * 在线程环境下逐个执行本批定时器函数。之前的回调函数可能已经停止、删除或者重新配置
+             * 了本批中后面的定时器，所以每次回调前都在临界区内重新检查定时器仍然就绪并且配置
+             * 版本号没有变化，然后才取出当前的回调函数和参数；否则跳过该定时器
              */
-            if (uKernelVariable.Jiffies == pTimer->ExpiredTicks)
+            for (index = 0U; index < number; index++)
             {
-                ticks = 0U;
-            }
-            else if (uKernelVariable.Jiffies > pTimer->ExpiredTicks)
-            {
-                ticks = uKernelVariable.Jiffies - pTimer->ExpiredTicks;
+                CpuEnterCritical(&imask);
+                pTimer = TimerBatch[index].Timer;
+                if ((pTimer->Property & TIMER_PROP_READY) &&
+                        (pTimer->Generation == TimerBatch[index].Generation))
+                {
+                    pRoutine = pTimer->Routine;
+                    data     = pTimer->Argument;
+                }
+                else
+                {
+                    pRoutine = (TTimerRoutine)0;
+                    data     = (TArgument)0;
+                }
+                CpuLeaveCritical(imask);
+
+                if (pRoutine != (TTimerRoutine)0)
+                {
+                    pRoutine(data, TimerBatch[index].Ticks);
+                }
             }
-            else
+
+            /* 更新批处理统计数据，如果回调执行期间系统节拍已经前进则记为一次超时 */
+            CpuEnterCritical(&imask);
+            TimerBatchStats.Batches++;
+            TimerBatchStats.Timers += number;
+            if (number > TimerBatchStats.MaxBatchSize)
             {
-                ticks = TCLM_MAX_VALUE64 - pTimer->ExpiredTicks + uKernelVariable.Jiffies;
+                TimerBatchStats.MaxBatchSize = number;
             }
-
-            if (pTimer->Property & TIMER_PROP_ACCURATE)
+            for (index = 0U; index < number; index++)
             {
-                if (ticks >= pTimer->PeriodTicks)
+                if (TimerBatch[index].Ticks > TimerBatchStats.MaxLagTicks)
                 {
-                    uKernelVariable.Diagnosis |= KERNEL_DIAG_TIMER_ERROR;
-                    pTimer->Diagnosis |= TIMER_DIAG_OVERFLOW;
-                    uDebugAlarm("");
+                    TimerBatchStats.MaxLagTicks = TimerBatch[index].Ticks;
                 }
             }
-
-            /* 将定时器从期满队列中移出 */
-            uObjListRemoveNode(pTimer->ExpiredNode.Handle, &(pTimer->ExpiredNode));
-            pTimer->Property &= ~TIMER_PROP_EXPIRED;
-
-            /* 复制定时器函数和函数参数 */
-            pRoutine = pTimer->Routine;
-            data = pTimer->Argument;
-
+            if (uKernelVariable.Jiffies != jiffies)
+            {
+                TimerBatchStats.Overruns++;
+            }
             CpuLeaveCritical(imask);
-
-            /* 在线程环境下执行定时器函数 */
-            pRoutine(data, ticks);
         }
     }
 }
@@ -489,6 +886,7 @@ void uTimerCreateDaemon(void)
                   (void*)TimerDaemonStack,
                   (TBase32)TCLC_TIMER_DAEMON_STACK_BYTES,
                   (TPriority)TCLC_TIMER_DAEMON_PRIORITY,
+                  (TPriority)TCLC_TIMER_DAEMON_PRIORITY,
                   (TTimeTick)TCLC_TIMER_DAEMON_SLICE);
 
     /* 初始化相关的内核变量 */
@@ -511,6 +909,7 @@ void uTimerModuleInit(void)
     }
 
     memset(&TimerList, 0, sizeof(TimerList));
+    memset(&TimerBatchStats, 0, sizeof(TimerBatchStats));
 
     /* 初始化相关的内核变量 */
     uKernelVariable.TimerList = &TimerList;
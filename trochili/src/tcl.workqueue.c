@@ -0,0 +1,379 @@
+/*************************************************************************************************
+ *                                     Trochili RTOS Kernel                                      *
+ *                                  Copyright(C) 2016 LIUXUMING                                  *
+ *                                       www.trochili.com                                        *
+ *************************************************************************************************/
+#include <string.h>
+
+#include "tcl.types.h"
+#include "tcl.config.h"
+#include "tcl.cpu.h"
+#include "tcl.debug.h"
+#include "tcl.kernel.h"
+#include "tcl.thread.h"
+#include "tcl.timer.h"
+#include "tcl.workqueue.h"
+
+#if ((TCLC_WORKQUEUE_ENABLE) && (TCLC_TIMER_ENABLE))
+
+/* 工作线程只允许工作函数阻塞、延时和让出处理器，不接受其它线程管理API操作 */
+#define WORK_WORKER_ACAPI (THREAD_ACAPI_BLOCK | THREAD_ACAPI_DELAY | THREAD_ACAPI_YIELD)
+
+
+/*************************************************************************************************
+ *  功能：将工作项放入工作队列并唤醒一个空闲的工作线程                                           *
+ *  参数：(1) pItem 工作项结构地址                                                               *
+ *  返回：无                                                                                     *
+ *  说明：在临界区内调用，这里不进行调度，由调用者决定是否调度                                   *
+ *************************************************************************************************/
+static void QueueWorkItem(TWorkItem* pItem)
+{
+    TWorkQueue* pQueue = pItem->Queue;
+    TIndex index;
+
+    uObjListAddNode(&(pQueue->Handle[pItem->Priority]), &(pItem->LinkNode), eLinkPosTail);
+    pItem->Status = eWorkPending;
+
+    /* 工作线程全部忙碌时不必唤醒，空出来的工作线程会继续处理队列中的工作项 */
+    for (index = 0U; index < pQueue->WorkerNum; index++)
+    {
+        if (pQueue->Workers[index].Status == eThreadSuspended)
+        {
+            uThreadResumeFromISR(&(pQueue->Workers[index]));
+            break;
+        }
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：延时工作项的定时器回调函数                                                             *
+ *  参数：(1) data  工作项结构地址                                                               *
+ *        (2) ticks 定时器回调的延迟节拍数                                                       *
+ *  返回：无                                                                                     *
+ *  说明：定时器在时钟节拍中断中回调本函数，退出中断时会进行调度                                 *
+ *************************************************************************************************/
+static void WorkTimerRoutine(TArgument data, TTimeTick ticks)
+{
+    TWorkItem* pItem = (TWorkItem*)data;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    /* 工作项可能已经被取消；仍在执行的工作项等到本次执行结束时再进入工作队列 */
+    if (pItem->Status == eWorkDelayed)
+    {
+        if (pItem->Property & WORK_PROP_RUNNING)
+        {
+            pItem->Status = eWorkPending;
+        }
+        else
+        {
+            QueueWorkItem(pItem);
+        }
+    }
+
+    CpuLeaveCritical(imask);
+}
+
+
+/*************************************************************************************************
+ *  功能：工作线程的线程函数                                                                     *
+ *  参数：(1) argument 工作队列结构地址                                                          *
+ *  返回：无                                                                                     *
+ *  说明：每次从优先级最高的非空桶的头部取出一个工作项执行，队列为空时工作线程将自己挂起         *
+ *************************************************************************************************/
+static void xWorkerEntry(TArgument argument)
+{
+    TReg32      imask;
+    TWorkQueue* pQueue = (TWorkQueue*)argument;
+    TWorkItem*  pItem;
+    TIndex      index;
+
+    while(eTrue)
+    {
+        CpuEnterCritical(&imask);
+
+        pItem = (TWorkItem*)0;
+        for (index = 0U; index < TCLC_WORKQUEUE_PRIORITY_NUM; index++)
+        {
+            if (pQueue->Handle[index] != (TLinkNode*)0)
+            {
+                pItem = (TWorkItem*)(pQueue->Handle[index]->Owner);
+                uObjListRemoveNode(pItem->LinkNode.Handle, &(pItem->LinkNode));
+                pItem->Status = eWorkRunning;
+                pItem->Property |= WORK_PROP_RUNNING;
+                break;
+            }
+        }
+
+        if (pItem == (TWorkItem*)0)
+        {
+            uThreadSuspendSelf();
+            CpuLeaveCritical(imask);
+        }
+        else
+        {
+            CpuLeaveCritical(imask);
+
+            pItem->Entry(pItem->Argument);
+
+            /*
+             * 工作项在执行期间可能被重新提交，延时提交的保持等待延时状态，
+             * 立即提交的现在才进入工作队列
+             */
+            CpuEnterCritical(&imask);
+            pItem->Property &= ~WORK_PROP_RUNNING;
+            if (pItem->Status == eWorkRunning)
+            {
+                pItem->Status = eWorkIdle;
+            }
+            else if (pItem->Status == eWorkPending)
+            {
+                QueueWorkItem(pItem);
+            }
+            CpuLeaveCritical(imask);
+        }
+    }
+}
+
+
+/*************************************************************************************************
+ *  功能：初始化工作队列和工作线程池                                                             *
+ *  参数：(1) pQueue     工作队列结构地址                                                        *
+ *        (2) pName      工作队列名称                                                            *
+ *        (3) pStack     全部工作线程的栈空间地址，各个工作线程依次划分使用                      *
+ *        (4) bytes      每个工作线程的栈大小，以字节为单位                                      *
+ *        (5) workers    工作线程数目                                                            *
+ *        (6) priority   工作线程优先级                                                          *
+ *        (7) ticks      工作线程时间片长度                                                      *
+ *        (8) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xWorkQueueCreate(TWorkQueue* pQueue, TChar* pName, void* pStack, TBase32 bytes,
+                        TBase32 workers, TPriority priority, TTimeTick ticks, TError* pError)
+{
+    TState state = eFailure;
+    TError error = WORK_ERR_FAULT;
+    TError thrError;
+    TIndex index;
+
+    /* 各个工作线程的栈从同一块栈空间中依次划分，栈大小必须保证每个栈都按照8字节对齐 */
+    KNL_ASSERT((((TAddr32)pStack & 0x7U) == 0U), "");
+    KNL_ASSERT(((bytes & 0x7U) == 0U), "");
+
+    if (!(pQueue->Property & WORK_PROP_READY))
+    {
+        memset(pQueue->Handle, 0, sizeof(pQueue->Handle));
+        pQueue->WorkerNum = 0U;
+
+        for (index = 0U; index < workers; index++)
+        {
+            state = xThreadCreate(&(pQueue->Workers[index]),
+                                  pName,
+                                  eThreadSuspended,
+                                  THREAD_PROP_PRIORITY_SAFE,
+                                  WORK_WORKER_ACAPI,
+                                  xWorkerEntry,
+                                  (TArgument)pQueue,
+                                  (void*)((TByte*)pStack + index * bytes),
+                                  bytes,
+                                  priority,
+                                  priority,
+                                  ticks,
+                                  &thrError);
+            if (state != eSuccess)
+            {
+                break;
+            }
+            pQueue->WorkerNum++;
+        }
+
+        /* 至少有一个工作线程创建成功，工作队列就可以使用 */
+        if (pQueue->WorkerNum > 0U)
+        {
+            pQueue->Property = WORK_PROP_READY;
+            error = WORK_ERR_NONE;
+            state = eSuccess;
+        }
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：初始化工作项                                                                           *
+ *  参数：(1) pItem      工作项结构地址                                                          *
+ *        (2) pName      工作项名称，也是工作项延时定时器的名称                                  *
+ *        (3) pQueue     工作项所属的工作队列                                                    *
+ *        (4) pEntry     工作函数                                                                *
+ *        (5) data       工作函数参数                                                            *
+ *        (6) priority   工作项优先级                                                            *
+ *        (7) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState xWorkItemCreate(TWorkItem* pItem, TChar* pName, TWorkQueue* pQueue, TWorkEntry pEntry,
+                       TArgument data, TPriority priority, TError* pError)
+{
+    TState state = eFailure;
+    TError error = WORK_ERR_UNREADY;
+    TError tmrError;
+
+    if (pQueue->Property & WORK_PROP_READY)
+    {
+        error = WORK_ERR_FAULT;
+        if (!(pItem->Property & WORK_PROP_READY))
+        {
+            /* 延时定时器的回调函数只做入队操作，所以直接在时钟节拍中断中执行 */
+            state = xTimerCreate(&(pItem->Timer), pName, TIMER_PROP_ISR, 0U,
+                                 WorkTimerRoutine, (TArgument)pItem, priority, &tmrError);
+            if (state == eSuccess)
+            {
+                pItem->Status          = eWorkIdle;
+                pItem->Priority        = priority;
+                pItem->Entry           = pEntry;
+                pItem->Argument        = data;
+                pItem->Queue           = pQueue;
+                pItem->LinkNode.Next   = (TLinkNode*)0;
+                pItem->LinkNode.Prev   = (TLinkNode*)0;
+                pItem->LinkNode.Handle = (TLinkNode**)0;
+                pItem->LinkNode.Data   = (TBase32*)0;
+                pItem->LinkNode.Owner  = (void*)pItem;
+                pItem->Property        = WORK_PROP_READY;
+                error = WORK_ERR_NONE;
+            }
+        }
+    }
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：提交工作项                                                                             *
+ *  参数：(1) pItem      工作项结构地址                                                          *
+ *        (2) ticks      延时提交的节拍数，为0时立即提交                                         *
+ *        (3) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：(1) 线程和ISR都可以调用本函数                                                          *
+ *        (2) 等待执行或者等待延时的工作项不能重复提交                                           *
+ *        (3) 正在执行的工作项可以再次提交，本次执行结束之后它才会进入工作队列                   *
+ *************************************************************************************************/
+TState xWorkItemSubmit(TWorkItem* pItem, TTimeTick ticks, TError* pError)
+{
+    TState state = eFailure;
+    TError error = WORK_ERR_UNREADY;
+    TError tmrError;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pItem->Property & WORK_PROP_READY)
+    {
+        if ((pItem->Status == eWorkIdle) || (pItem->Status == eWorkRunning))
+        {
+            /* 仍在执行的工作项只记录提交请求，由执行它的工作线程在执行结束时放入工作队列 */
+            if ((ticks == 0U) && (pItem->Property & WORK_PROP_RUNNING))
+            {
+                pItem->Status = eWorkPending;
+                error = WORK_ERR_NONE;
+                state = eSuccess;
+            }
+            else if (ticks == 0U)
+            {
+                QueueWorkItem(pItem);
+                if ((uKernelVariable.State == eThreadState) &&
+                        (uKernelVariable.SchedLockTimes == 0U))
+                {
+                    uThreadSchedule();
+                }
+                error = WORK_ERR_NONE;
+                state = eSuccess;
+            }
+            else
+            {
+                error = WORK_ERR_FAULT;
+                state = xTimerConfig(&(pItem->Timer), ticks, pItem->Priority, 0U, &tmrError);
+                if (state == eSuccess)
+                {
+                    state = xTimerStart(&(pItem->Timer), 0U, &tmrError);
+                }
+                if (state == eSuccess)
+                {
+                    pItem->Status = eWorkDelayed;
+                    error = WORK_ERR_NONE;
+                }
+            }
+        }
+        else
+        {
+            error = WORK_ERR_STATUS;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：取消工作项                                                                             *
+ *  参数：(1) pItem      工作项结构地址                                                          *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：只能取消等待执行或者等待延时的工作项，正在执行的工作项只能取消它被再次提交的请求       *
+ *************************************************************************************************/
+TState xWorkItemCancel(TWorkItem* pItem, TError* pError)
+{
+    TState state = eFailure;
+    TError error = WORK_ERR_UNREADY;
+    TError tmrError;
+    TReg32 imask;
+
+    CpuEnterCritical(&imask);
+
+    if (pItem->Property & WORK_PROP_READY)
+    {
+        if (pItem->Status == eWorkPending)
+        {
+            /* 执行期间被再次提交的工作项还没有进入工作队列 */
+            if (pItem->LinkNode.Handle != (TLinkNode**)0)
+            {
+                uObjListRemoveNode(pItem->LinkNode.Handle, &(pItem->LinkNode));
+            }
+            pItem->Status = (pItem->Property & WORK_PROP_RUNNING) ? eWorkRunning : eWorkIdle;
+            error = WORK_ERR_NONE;
+            state = eSuccess;
+        }
+        else if (pItem->Status == eWorkDelayed)
+        {
+            /* 定时器可能已经到时，回调函数看到工作项不再等待延时就不会再提交它 */
+            xTimerStop(&(pItem->Timer), &tmrError);
+            pItem->Status = (pItem->Property & WORK_PROP_RUNNING) ? eWorkRunning : eWorkIdle;
+            error = WORK_ERR_NONE;
+            state = eSuccess;
+        }
+        else
+        {
+            error = WORK_ERR_STATUS;
+        }
+    }
+
+    CpuLeaveCritical(imask);
+
+    *pError = error;
+    return state;
+}
+
+#endif
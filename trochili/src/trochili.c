@@ -85,16 +85,59 @@ void TclGetTimeJiffies(TTimeTick* pJiffies)
  *  功能：获得系统已运行时间戳                                                                   *
  *  参数：(1) pStamp 以微秒为单位的时间戳数值                                                    *
  *  返回：无                                                                                     *
- *  说明：                                                                                       *
+ *  说明：时间戳精度不受时钟节拍频率限制                                                         *
  *************************************************************************************************/
 void TclGetTimeStamp(TTimeStamp* pStamp)
 {
-    TTimeTick jiffies;
     KNL_ASSERT((pStamp != (TTimeStamp*)0), "");
+    xKernelGetTimeStamp(pStamp);
+}
+
+
+#if (TCLC_KERNEL_PROFILE_ENABLE)
+/*************************************************************************************************
+ *  功能：获得中断执行时间统计数据                                                               *
+ *  参数：(1) index    中断统计项编号，即物理中断号或者KERNEL_PROFILE_TICK_ISR                   *
+ *        (2) pProfile 返回中断执行时间统计数据                                                  *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：统计时间以处理器周期为单位                                                             *
+ *************************************************************************************************/
+TState TclGetIsrProfile(TIndex index, TIsrProfile* pProfile)
+{
+    TState state;
+    KNL_ASSERT((index < KERNEL_PROFILE_ISR_NUM), "");
+    KNL_ASSERT((pProfile != (TIsrProfile*)0), "");
+
+    state = xKernelGetIsrProfile(index, pProfile);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：获得临界区关中断时间统计数据                                                           *
+ *  参数：(1) pProfile 返回临界区关中断时间统计数据                                              *
+ *  返回：无                                                                                     *
+ *  说明：统计时间以处理器周期为单位                                                             *
+ *************************************************************************************************/
+void TclGetCriticalProfile(TCriticalProfile* pProfile)
+{
+    KNL_ASSERT((pProfile != (TCriticalProfile*)0), "");
+    xKernelGetCriticalProfile(pProfile);
+}
+
 
-    xKernelGetJiffies(&jiffies);
-    *pStamp = (jiffies * 1000U * 1000U) / TCLC_TIME_TICK_RATE;
+/*************************************************************************************************
+ *  功能：清除内核性能统计数据                                                                   *
+ *  参数：无                                                                                     *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+void TclResetProfile(void)
+{
+    xKernelResetProfile();
 }
+#endif
 
 
 #if (TCLC_IRQ_ENABLE)
@@ -226,6 +269,7 @@ TState TclCreateThread(TThread*     pThread,
                           pStack,
                           bytes,
                           priority,
+                          priority,
                           ticks,
                           pError);
 
@@ -370,6 +414,93 @@ TState TclSetThreadSlice(TThread* pThread, TTimeTick ticks, TError* pError)
 }
 
 
+/*************************************************************************************************
+ *  功能：线程抢占阈值修改API                                                                    *
+ *  参数：(1) pThread   线程结构地址                                                             *
+ *        (2) threshold 线程抢占阈值                                                             *
+ *  返回：参考线程相关返回值定义                                                                 *
+ *  说明：线程运行时只能被优先级高于抢占阈值的线程抢占，相互协作的一组线程可以使用相同的阈值     *
+ *        来避免彼此抢占。线程创建时抢占阈值等于线程优先级                                       *
+ *************************************************************************************************/
+TState TclSetThreadThreshold(TThread* pThread, TPriority threshold, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((threshold >= TCLC_USER_PRIORITY_HIGH), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xThreadSetThreshold(pThread, threshold, pError);
+    return state;
+}
+
+
+#if (TCLC_THREAD_CYCLE_ENABLE)
+/*************************************************************************************************
+ *  功能：获得线程运行时间统计数据API                                                            *
+ *  参数：(1) pThread  线程结构地址，为空时表示当前线程                                          *
+ *        (2) pStats   返回线程运行时间统计数据                                                  *
+ *  返回：参考线程相关返回值定义                                                                 *
+ *  说明：运行时间以处理器周期为单位，负载以千分比为单位                                         *
+ *************************************************************************************************/
+TState TclGetThreadStats(TThread* pThread, TThreadStats* pStats, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pStats != (TThreadStats*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xThreadGetStats(pThread, pStats, pError);
+    return state;
+}
+#endif
+
+
+#if (TCLC_THREAD_EDF_ENABLE)
+/*************************************************************************************************
+ *  功能：设置EDF线程截止期API                                                                   *
+ *  参数：(1) pThread 线程结构地址                                                               *
+ *        (2) ticks   从现在开始到截止期的时钟节拍数                                             *
+ *  返回：参考线程相关返回值定义                                                                 *
+ *  说明：以TCLC_THREAD_EDF_PRIORITY优先级创建的线程是EDF线程，按照截止期先后调度                *
+ *************************************************************************************************/
+TState TclSetThreadDeadline(TThread* pThread, TTimeTick ticks, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((ticks > 0U), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xThreadSetDeadline(pThread, ticks, pError);
+    return state;
+}
+#endif
+
+
+#if (TCLC_THREAD_BUDGET_ENABLE)
+/*************************************************************************************************
+ *  功能：设置线程CPU预算API                                                                     *
+ *  参数：(1) pThread  线程结构地址                                                              *
+ *        (2) budget   每个补充周期内线程可以运行的时钟节拍数，为0时取消CPU预算限制              *
+ *        (3) period   CPU预算的补充周期                                                         *
+ *        (4) option   CPU预算耗尽时降低优先级(TCLO_THREAD_BUDGET_DEMOTE)或者挂起线程            *
+ *                     (TCLO_THREAD_BUDGET_SUSPEND)                                              *
+ *        (5) priority CPU预算耗尽时线程被降低到的后台优先级                                     *
+ *  返回：参考线程相关返回值定义                                                                 *
+ *  说明：预算在线程运行的时钟节拍中扣除，从满额预算开始消耗后经过补充周期一次补满               *
+ *************************************************************************************************/
+TState TclSetThreadBudget(TThread* pThread, TTimeTick budget, TTimeTick period,
+                          TOption option, TPriority priority, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((budget <= period), "");
+    KNL_ASSERT(((option == THREAD_BUDGET_DEMOTE) || (option == THREAD_BUDGET_SUSPEND)), "");
+    KNL_ASSERT((priority <= TCLC_USER_PRIORITY_LOW), "");
+    KNL_ASSERT((priority >= TCLC_USER_PRIORITY_HIGH), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xThreadSetBudget(pThread, budget, period, option, priority, pError);
+    return state;
+}
+#endif
+
+
 /*************************************************************************************************
  *  功能：线程延时模块接口函数                                                                   *
  *  参数：(1) pThread 线程结构地址                                                               *
@@ -895,6 +1026,109 @@ TState TclFlushMailBox(TMailBox* pMailbox, TError* pError)
 #endif
 
 
+#if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_MAILBOX_ENABLE)&&(TCLC_IPC_MMBOX_ENABLE))
+/*************************************************************************************************
+ *  功能：初始化多槽邮箱                                                                         *
+ *  参数：(1) pMailbox   邮箱的地址                                                              *
+ *        (2) pName      邮箱的名称                                                              *
+ *        (3) pSlots     邮件槽位数组地址                                                        *
+ *        (4) depth      邮件槽位数目                                                            *
+ *        (5) property   邮箱的初始属性，TCLP_IPC_OVERWRITE表示覆盖写模式                        *
+ *        (6) pError     详细调用结果                                                            *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclCreateMultiMailBox(TMultiMailBox* pMailbox, TChar* pName, TMail* pSlots, TBase32 depth,
+                             TProperty property, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pMailbox != (TMultiMailBox*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pSlots != (TMail*)0), "");
+    KNL_ASSERT((depth > 0U), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    property &= IPC_USER_MMBOX_PROP;
+    state = xMultiMailBoxCreate(pMailbox, pName, pSlots, depth, property, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：删除多槽邮箱                                                                           *
+ *  参数：(1) pMailbox   邮箱的地址                                                              *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclDeleteMultiMailBox(TMultiMailBox* pMailbox, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pMailbox != (TMultiMailBox*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xMultiMailBoxDelete(pMailbox, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR从多槽邮箱中读取邮件                                                           *
+ *  参数: (1) pMailbox 邮箱结构地址                                                              *
+ *        (2) pMail2   保存邮件结构地址的指针变量                                                *
+ *        (3) option   访问邮箱的模式                                                            *
+ *        (4) timeo    时限阻塞模式下访问邮箱的时限长度                                          *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclReceiveMultiMail(TMultiMailBox* pMailbox, TMail* pMail2, TOption option, TTimeTick timeo,
+                           TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pMailbox != (TMultiMailBox*)0), "");
+    KNL_ASSERT((pMail2 != (TMail*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_MMBOX_OPTION;
+    state = xMultiMailBoxReceive(pMailbox, pMail2, option, timeo, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR向多槽邮箱中发送邮件                                                           *
+ *  参数: (1) pMailbox 邮箱结构地址                                                              *
+ *        (2) pMail2   保存邮件结构地址的指针变量                                                *
+ *        (3) option   访问邮箱的模式                                                            *
+ *        (4) timeo    时限阻塞模式下访问邮箱的时限长度                                          *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：覆盖写模式的邮箱满时丢弃最早的邮件                                                     *
+ *************************************************************************************************/
+TState TclSendMultiMail(TMultiMailBox* pMailbox, TMail* pMail2, TOption option, TTimeTick timeo,
+                        TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pMailbox != (TMultiMailBox*)0), "");
+    KNL_ASSERT((pMail2 != (TMail*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_MMBOX_OPTION;
+    state = xMultiMailBoxSend(pMailbox, pMail2, option, timeo, pError);
+    return state;
+}
+#endif
+
+
 #if ((TCLC_IPC_ENABLE)&&(TCLC_IPC_MQUE_ENABLE))
 /*************************************************************************************************
  *  功能：消息队列初始化函数                                                                     *
@@ -978,6 +1212,68 @@ TState TclSendMessage(TMsgQueue* pMsgQue, TMessage* pMsg2, TOption option, TTime
 }
 
 
+/*************************************************************************************************
+ *  功能: 用于线程/ISR批量接收消息队列中的消息                                                   *
+ *  参数: (1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pMsgs    保存消息的数组地址                                                        *
+ *        (3) number   最多接收的消息数目                                                        *
+ *        (4) pCount   实际接收的消息数目                                                        *
+ *        (5) option   访问消息队列的模式                                                        *
+ *        (6) timeo    时限阻塞模式下访问消息队列的时限长度                                      *
+ *        (7) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：只要接收到至少一个消息就返回成功                                                       *
+ *************************************************************************************************/
+TState TclReceiveMessages(TMsgQueue* pMsgQue, TMessage* pMsgs, TBase32 number, TBase32* pCount,
+                          TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pMsgQue != (TMsgQueue*)0), "");
+    KNL_ASSERT((pMsgs != (TMessage*)0), "");
+    KNL_ASSERT((number > 0U), "");
+    KNL_ASSERT((pCount != (TBase32*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_MSGQ_OPTION;
+    state = xMQReceiveBatch(pMsgQue, pMsgs, number, pCount, option, timeo, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 用于线程/ISR向消息队列中批量发送消息                                                   *
+ *  参数: (1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pMsgs    待发送的消息数组地址                                                      *
+ *        (3) number   待发送的消息数目                                                          *
+ *        (4) pCount   实际发送的消息数目                                                        *
+ *        (5) option   访问消息队列的模式                                                        *
+ *        (6) timeo    时限阻塞模式下访问消息队列的时限长度                                      *
+ *        (7) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：只要发送出至少一个消息就返回成功                                                       *
+ *************************************************************************************************/
+TState TclSendMessages(TMsgQueue* pMsgQue, TMessage* pMsgs, TBase32 number, TBase32* pCount,
+                       TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pMsgQue != (TMsgQueue*)0), "");
+    KNL_ASSERT((pMsgs != (TMessage*)0), "");
+    KNL_ASSERT((number > 0U), "");
+    KNL_ASSERT((pCount != (TBase32*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_MSGQ_OPTION;
+    state = xMQSendBatch(pMsgQue, pMsgs, number, pCount, option, timeo, pError);
+    return state;
+}
+
+
 /*************************************************************************************************
  *  功能: 用于ISR向消息队列中发送消息                                                            *
  *  参数: (1) pMsgQue  消息队列结构地址                                                          *
@@ -1083,290 +1379,1461 @@ TState TclFlushMsgQueue(TMsgQueue* pMsgQue, TError* pError)
 #endif
 
 
-#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_FLAGS_ENABLE))
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_MQUE_ENABLE) && (TCLC_IPC_MQUE_LOAN_ENABLE) && (TCLC_MEMORY_ENABLE) && (TCLC_MEMORY_POOL_ENABLE))
 /*************************************************************************************************
- *  功能：初始化事件标记                                                                         *
- *  参数：(1) pFlags     事件标记的地址                                                          *
- *        (2) pName      事件标记的名称                                                          *
- *        (3) property   事件标记的初始属性                                                      *
- *        (4) pError     函数调用详细返回值                                                      *
- *  返回: (1) eFailure   操作失败                                                                *
- *        (2) eSuccess   操作成功                                                                *
+ *  功能：为消息队列绑定借出缓冲区的内存池                                                       *
+ *  参数：(1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pPool    内存池结构地址                                                            *
+ *        (3) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
  *  说明：                                                                                       *
  *************************************************************************************************/
-TState TclCreateFlags(TFlags* pFlags, TChar* pName, TProperty property, TError* pError)
+TState TclBindMsgQueuePool(TMsgQueue* pMsgQue, TMemPool* pPool, TError* pError)
 {
     TState state;
-    KNL_ASSERT((pFlags != (TFlags*)0), "");
-    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pMsgQue != (TMsgQueue*)0), "");
+    KNL_ASSERT((pPool != (TMemPool*)0), "");
     KNL_ASSERT((pError != (TError*)0), "");
 
-    property &= IPC_USER_FLAG_PROP;
-    state = xFlagsCreate(pFlags, pName, property, pError);
+    state = xMQBindPool(pMsgQue, pPool, pError);
     return state;
 }
 
 
 /*************************************************************************************************
- *  功能：取消事件标记初始化                                                                     *
- *  参数：(1) pFlags   事件标记的地址                                                            *
- *        (2) pError   函数调用详细返回值                                                        *
- *  返回: (1) eFailure 操作失败                                                                  *
- *        (2) eSuccess 操作成功                                                                  *
+ *  功能：从消息队列绑定的内存池中借出一个消息缓冲区                                             *
+ *  参数：(1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pBuf2    保存缓冲区地址的指针变量                                                  *
+ *        (3) option   访问内存池的模式                                                          *
+ *        (4) timeo    时限阻塞模式下等待缓冲区的时限长度                                        *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
  *  说明：                                                                                       *
  *************************************************************************************************/
-TState TclDeleteFlags(TFlags* pFlags, TError* pError)
+TState TclLoanMsgBuffer(TMsgQueue* pMsgQue, void** pBuf2, TOption option, TTimeTick timeo,
+                        TError* pError)
 {
     TState state;
-    KNL_ASSERT((pFlags != (TFlags*)0), "");
+    KNL_ASSERT((pMsgQue != (TMsgQueue*)0), "");
+    KNL_ASSERT((pBuf2 != (void**)0), "");
     KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
 
-    state = xFlagsDelete(pFlags, pError);
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_LOAN_OPTION;
+    state = xMQLoanBuffer(pMsgQue, pBuf2, option, timeo, pError);
     return state;
 }
 
 
 /*************************************************************************************************
- *  功能：线程/ISR向事件标记发送事件                                                             *
- *  参数：(1) pFlags   事件标记的地址                                                            *
- *        (2) pPattern 需要接收的标记的组合                                                      *
- *        (3) pError   详细调用结果                                                              *
- *  返回: (1) eFailure   操作失败                                                                *
- *        (2) eSuccess   操作成功                                                                *
- *  说明：本函数不会引起当前线程阻塞                                                             *
+ *  功能：把借出的缓冲区作为消息提交到消息队列                                                   *
+ *  参数：(1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pBuf     借出的缓冲区地址                                                          *
+ *        (3) option   访问消息队列的模式                                                        *
+ *        (4) timeo    时限阻塞模式下访问消息队列的时限长度                                      *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：                                                                                       *
  *************************************************************************************************/
-TState TclSendFlags(TFlags* pFlags, TBitMask pattern, TError* pError)
+TState TclCommitMsgBuffer(TMsgQueue* pMsgQue, void* pBuf, TOption option, TTimeTick timeo,
+                          TError* pError)
 {
     TState state;
-    KNL_ASSERT((pFlags != (TFlags*)0), "");
+    KNL_ASSERT((pMsgQue != (TMsgQueue*)0), "");
+    KNL_ASSERT((pBuf != (void*)0), "");
     KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
 
-    state = xFlagsSend(pFlags, pattern, pError);
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_MSGQ_OPTION;
+    state = xMQCommitBuffer(pMsgQue, pBuf, option, timeo, pError);
     return state;
 }
 
 
 /*************************************************************************************************
- *  功能：线程/ISR接收事件标记                                                                   *
- *  参数：(1) pFlags   事件标记的地址                                                            *
- *        (2) pPattern 需要接收的标记的组合                                                      *
- *        (3) timeo    时限阻塞模式下访问事件标记的时限长度                                      *
- *        (4) option   访问事件标记的参数                                                        *
- *        (5) pError   详细调用结果                                                              *
- *  返回: (1) eFailure 操作失败                                                                  *
- *        (2) eSuccess 操作成功                                                                  *
+ *  功能：接收线程归还用完的缓冲区                                                               *
+ *  参数：(1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pBuf     缓冲区地址                                                                *
+ *        (3) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
  *  说明：                                                                                       *
  *************************************************************************************************/
-TState TclReceiveFlags(TFlags* pFlags, TBitMask* pPattern, TOption option, TTimeTick timeo,
-                       TError* pError)
+TState TclReturnMsgBuffer(TMsgQueue* pMsgQue, void* pBuf, TError* pError)
 {
     TState state;
+    KNL_ASSERT((pMsgQue != (TMsgQueue*)0), "");
+    KNL_ASSERT((pBuf != (void*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
 
-    KNL_ASSERT((pFlags != (TFlags*)0), "");
+    state = xMQReturnBuffer(pMsgQue, pBuf, pError);
+    return state;
+}
+#endif
+
+
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_FLAGS_ENABLE))
+/*************************************************************************************************
+ *  功能：初始化事件标记                                                                         *
+ *  参数：(1) pFlags     事件标记的地址                                                          *
+ *        (2) pName      事件标记的名称                                                          *
+ *        (3) property   事件标记的初始属性                                                      *
+ *        (4) pError     函数调用详细返回值                                                      *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclCreateFlags(TFlags* pFlags, TChar* pName, TProperty property, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pFlags != (TFlags*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    property &= IPC_USER_FLAG_PROP;
+    state = xFlagsCreate(pFlags, pName, property, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：取消事件标记初始化                                                                     *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pError   函数调用详细返回值                                                        *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclDeleteFlags(TFlags* pFlags, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pFlags != (TFlags*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xFlagsDelete(pFlags, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：线程/ISR向事件标记发送事件                                                             *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pPattern 需要接收的标记的组合                                                      *
+ *        (3) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：本函数不会引起当前线程阻塞                                                             *
+ *************************************************************************************************/
+TState TclSendFlags(TFlags* pFlags, TBitMask pattern, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pFlags != (TFlags*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xFlagsSend(pFlags, pattern, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：线程/ISR接收事件标记                                                                   *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pPattern 需要接收的标记的组合                                                      *
+ *        (3) timeo    时限阻塞模式下访问事件标记的时限长度                                      *
+ *        (4) option   访问事件标记的参数                                                        *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclReceiveFlags(TFlags* pFlags, TBitMask* pPattern, TOption option, TTimeTick timeo,
+                       TError* pError)
+{
+    TState state;
+
+    KNL_ASSERT((pFlags != (TFlags*)0), "");
+    KNL_ASSERT((option & (IPC_OPT_AND | IPC_OPT_OR)) != 0U, "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_FLAG_OPTION;
+    state = xFlagsReceive(pFlags, pPattern, option, timeo, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 清除事件标记阻塞队列                                                                   *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclResetFlags(TFlags* pFlags, TError* pError)
+{
+    TState state;
+
+    KNL_ASSERT((pFlags != (TFlags*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xFlagsReset(pFlags, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：事件标记终止函数,将指定的线程从事件标记的线程阻塞队列中终止阻塞并唤醒                  *
+ *  参数：(1) pFlags   事件标记结构地址                                                          *
+ *        (2) option   参数选项                                                                  *
+ *        (3) pThread  线程地址                                                                  *
+ *        (4) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess                                                                           *
+ *        (2) eFailure                                                                           *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclFlushFlags(TFlags* pFlags, TError* pError)
+{
+    TState state = eFailure;
+    KNL_ASSERT((pFlags != (TFlags*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xFlagsFlush(pFlags, pError);
+    return state;
+}
+#endif
+
+
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_FLAGS_ENABLE) && (TCLC_IPC_FLAGS64_ENABLE))
+/*************************************************************************************************
+ *  功能：初始化64位事件标记                                                                     *
+ *  参数：(1) pFlags     事件标记的地址                                                          *
+ *        (2) pName      事件标记的名称                                                          *
+ *        (3) property   事件标记的初始属性                                                      *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclCreateFlags64(TFlags64* pFlags, TChar* pName, TProperty property, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pFlags != (TFlags64*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    property &= IPC_USER_FLAG_PROP;
+    state = xFlags64Create(pFlags, pName, property, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：取消64位事件标记初始化                                                                 *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclDeleteFlags64(TFlags64* pFlags, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pFlags != (TFlags64*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xFlags64Delete(pFlags, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：线程/ISR向64位事件标记发送事件                                                         *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pattern  需要发送的标记的组合                                                      *
+ *        (3) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：本函数不会引起当前线程阻塞                                                             *
+ *************************************************************************************************/
+TState TclSendFlags64(TFlags64* pFlags, TBitMask64 pattern, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pFlags != (TFlags64*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xFlags64Send(pFlags, pattern, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：线程/ISR接收64位事件标记                                                               *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pPattern 需要接收的标记的组合                                                      *
+ *        (3) option   访问事件标记的参数                                                        *
+ *        (4) timeo    时限阻塞模式下访问事件标记的时限长度                                      *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclReceiveFlags64(TFlags64* pFlags, TBitMask64* pPattern, TOption option, TTimeTick timeo,
+                         TError* pError)
+{
+    TState state;
+
+    KNL_ASSERT((pFlags != (TFlags64*)0), "");
+    KNL_ASSERT((pPattern != (TBitMask64*)0), "");
+    KNL_ASSERT((*pPattern != 0U), "");
     KNL_ASSERT((option & (IPC_OPT_AND | IPC_OPT_OR)) != 0U, "");
     KNL_ASSERT((pError != (TError*)0), "");
-    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_FLAG_OPTION;
+    state = xFlags64Receive(pFlags, pPattern, option, timeo, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 重置64位事件标记                                                                       *
+ *  参数：(1) pFlags   事件标记的地址                                                            *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure   操作失败                                                                *
+ *        (2) eSuccess   操作成功                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclResetFlags64(TFlags64* pFlags, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pFlags != (TFlags64*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xFlags64Reset(pFlags, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：释放64位事件标记阻塞队列上的全部线程                                                   *
+ *  参数：(1) pFlags   事件标记结构地址                                                          *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess                                                                           *
+ *        (2) eFailure                                                                           *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclFlushFlags64(TFlags64* pFlags, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pFlags != (TFlags64*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xFlags64Flush(pFlags, pError);
+    return state;
+}
+#endif
+
+
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_RWLOCK_ENABLE))
+/*************************************************************************************************
+ *  功能: 初始化读写锁                                                                           *
+ *  参数: (1) pRwLock    读写锁结构地址                                                          *
+ *        (2) pName      读写锁的名称                                                            *
+ *        (3) property   读写锁的初始属性                                                        *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclCreateRwLock(TRwLock* pRwLock, TChar* pName, TProperty property, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pRwLock != (TRwLock*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    property &= IPC_USER_RWLOCK_PROP;
+    state = xRwLockCreate(pRwLock, pName, property, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 删除读写锁                                                                             *
+ *  参数: (1) pRwLock    读写锁结构地址                                                          *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：注意线程的等待结果都是TCLE_IPC_DELETE                                                  *
+ *************************************************************************************************/
+TState TclDeleteRwLock(TRwLock* pRwLock, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pRwLock != (TRwLock*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xRwLockDelete(pRwLock, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR获得读锁                                                                       *
+ *  参数: (1) pRwLock    读写锁结构地址                                                          *
+ *        (2) option     访问读写锁的模式                                                        *
+ *        (3) timeo      时限阻塞模式下访问读写锁的时限长度                                      *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：ISR中只能以非阻塞方式尝试获得读锁                                                      *
+ *************************************************************************************************/
+TState TclReadLock(TRwLock* pRwLock, TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pRwLock != (TRwLock*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_RWLOCK_OPTION;
+    state = xRwLockRead(pRwLock, option, timeo, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程获得写锁                                                                           *
+ *  参数: (1) pRwLock    读写锁结构地址                                                          *
+ *        (2) option     访问读写锁的模式                                                        *
+ *        (3) timeo      时限阻塞模式下访问读写锁的时限长度                                      *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclWriteLock(TRwLock* pRwLock, TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pRwLock != (TRwLock*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_RWLOCK_OPTION;
+    state = xRwLockWrite(pRwLock, option, timeo, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 释放读写锁                                                                             *
+ *  参数: (1) pRwLock    读写锁结构地址                                                          *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：持有写锁的线程释放写锁，其它情况释放一个读锁                                           *
+ *************************************************************************************************/
+TState TclUnlockRwLock(TRwLock* pRwLock, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pRwLock != (TRwLock*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xRwLockUnlock(pRwLock, pError);
+    return state;
+}
+#endif
+
+
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_MUTEX_ENABLE) && (TCLC_IPC_CONDVAR_ENABLE))
+/*************************************************************************************************
+ *  功能: 初始化条件变量                                                                         *
+ *  参数: (1) pCondVar   条件变量结构地址                                                        *
+ *        (2) pName      条件变量的名称                                                          *
+ *        (3) pMutex     条件变量绑定的互斥量                                                    *
+ *        (4) property   条件变量的初始属性                                                      *
+ *        (5) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclCreateCondVar(TCondVar* pCondVar, TChar* pName, TMutex* pMutex, TProperty property,
+                        TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pCondVar != (TCondVar*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pMutex != (TMutex*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    property &= IPC_USER_CONDVAR_PROP;
+    state = xCondVarCreate(pCondVar, pName, pMutex, property, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 删除条件变量                                                                           *
+ *  参数: (1) pCondVar   条件变量结构地址                                                        *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：注意线程的等待结果都是TCLE_IPC_DELETE                                                  *
+ *************************************************************************************************/
+TState TclDeleteCondVar(TCondVar* pCondVar, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pCondVar != (TCondVar*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xCondVarDelete(pCondVar, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程在条件变量上等待                                                                   *
+ *  参数: (1) pCondVar   条件变量结构地址                                                        *
+ *        (2) option     等待条件变量的模式                                                      *
+ *        (3) timeo      时限阻塞模式下等待条件变量的时限长度                                    *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：调用前当前线程必须占有绑定的互斥量，函数返回时线程仍然占有该互斥量                     *
+ *************************************************************************************************/
+TState TclWaitCondVar(TCondVar* pCondVar, TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pCondVar != (TCondVar*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_CONDVAR_OPTION;
+    state = xCondVarWait(pCondVar, option, timeo, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 通知一个在条件变量上等待的线程                                                         *
+ *  参数: (1) pCondVar   条件变量结构地址                                                        *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclSignalCondVar(TCondVar* pCondVar, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pCondVar != (TCondVar*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xCondVarSignal(pCondVar, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 通知全部在条件变量上等待的线程                                                         *
+ *  参数: (1) pCondVar   条件变量结构地址                                                        *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclBroadcastCondVar(TCondVar* pCondVar, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pCondVar != (TCondVar*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xCondVarBroadcast(pCondVar, pError);
+    return state;
+}
+#endif
+
+
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_BARRIER_ENABLE))
+/*************************************************************************************************
+ *  功能: 初始化屏障                                                                             *
+ *  参数: (1) pBarrier   屏障结构地址                                                            *
+ *        (2) pName      屏障的名称                                                              *
+ *        (3) parties    每一轮需要到达屏障的线程数目                                            *
+ *        (4) property   屏障的初始属性                                                          *
+ *        (5) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclCreateBarrier(TBarrier* pBarrier, TChar* pName, TBase32 parties, TProperty property,
+                        TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pBarrier != (TBarrier*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((parties > 0U), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    property &= IPC_USER_BARRIER_PROP;
+    state = xBarrierCreate(pBarrier, pName, parties, property, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 删除屏障                                                                               *
+ *  参数: (1) pBarrier   屏障结构地址                                                            *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：注意线程的等待结果都是TCLE_IPC_DELETE                                                  *
+ *************************************************************************************************/
+TState TclDeleteBarrier(TBarrier* pBarrier, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pBarrier != (TBarrier*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xBarrierDelete(pBarrier, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程到达屏障并等待其它线程                                                             *
+ *  参数: (1) pBarrier   屏障结构地址                                                            *
+ *        (2) option     等待屏障的模式                                                          *
+ *        (3) timeo      时限阻塞模式下等待屏障的时限长度                                        *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclWaitBarrier(TBarrier* pBarrier, TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pBarrier != (TBarrier*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_BARRIER_OPTION;
+    state = xBarrierWait(pBarrier, option, timeo, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 初始化门闩                                                                             *
+ *  参数: (1) pLatch     门闩结构地址                                                            *
+ *        (2) pName      门闩的名称                                                              *
+ *        (3) count      门闩的初始计数                                                          *
+ *        (4) property   门闩的初始属性                                                          *
+ *        (5) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclCreateLatch(TLatch* pLatch, TChar* pName, TBase32 count, TProperty property,
+                      TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pLatch != (TLatch*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    property &= IPC_USER_LATCH_PROP;
+    state = xLatchCreate(pLatch, pName, count, property, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 删除门闩                                                                               *
+ *  参数: (1) pLatch     门闩结构地址                                                            *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：注意线程的等待结果都是TCLE_IPC_DELETE                                                  *
+ *************************************************************************************************/
+TState TclDeleteLatch(TLatch* pLatch, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pLatch != (TLatch*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xLatchDelete(pLatch, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR使门闩计数减1                                                                  *
+ *  参数: (1) pLatch     门闩结构地址                                                            *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclCountDownLatch(TLatch* pLatch, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pLatch != (TLatch*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xLatchCountDown(pLatch, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR等待门闩打开                                                                   *
+ *  参数: (1) pLatch     门闩结构地址                                                            *
+ *        (2) option     等待门闩的模式                                                          *
+ *        (3) timeo      时限阻塞模式下等待门闩的时限长度                                        *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：ISR中只能以非阻塞方式查询门闩                                                          *
+ *************************************************************************************************/
+TState TclWaitLatch(TLatch* pLatch, TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pLatch != (TLatch*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_LATCH_OPTION;
+    state = xLatchWait(pLatch, option, timeo, pError);
+    return state;
+}
+#endif
+
+
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_STREAM_ENABLE))
+/*************************************************************************************************
+ *  功能: 初始化字节流缓冲区                                                                     *
+ *  参数: (1) pStream    字节流缓冲区结构地址                                                    *
+ *        (2) pName      字节流缓冲区的名称                                                      *
+ *        (3) pBuffer    环形缓冲区地址                                                          *
+ *        (4) size       环形缓冲区长度                                                          *
+ *        (5) trigger    唤醒读线程需要的最少字节数                                              *
+ *        (6) property   字节流缓冲区的初始属性                                                  *
+ *        (7) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：环形缓冲区最多保存size-1个字节，触发字节数不能超过这个数值                             *
+ *************************************************************************************************/
+TState TclCreateStreamBuffer(TStreamBuffer* pStream, TChar* pName, TByte* pBuffer, TBase32 size,
+                             TBase32 trigger, TProperty property, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pStream != (TStreamBuffer*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pBuffer != (TByte*)0), "");
+    KNL_ASSERT((size > 1U), "");
+    KNL_ASSERT((trigger > 0U) && (trigger < size), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    property &= IPC_USER_STREAM_PROP;
+    state = xStreamBufferCreate(pStream, pName, pBuffer, size, trigger, property, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 删除字节流缓冲区                                                                       *
+ *  参数: (1) pStream    字节流缓冲区结构地址                                                    *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：注意线程的等待结果都是TCLE_IPC_DELETE                                                  *
+ *************************************************************************************************/
+TState TclDeleteStreamBuffer(TStreamBuffer* pStream, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pStream != (TStreamBuffer*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xStreamBufferDelete(pStream, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR向字节流缓冲区写入数据                                                         *
+ *  参数: (1) pStream    字节流缓冲区结构地址                                                    *
+ *        (2) pData      待写入的数据地址                                                        *
+ *        (3) length     待写入的字节数                                                          *
+ *        (4) pCount     实际写入的字节数                                                        *
+ *        (5) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：同一个字节流缓冲区只能有一个生产者                                                     *
+ *************************************************************************************************/
+TState TclSendStream(TStreamBuffer* pStream, TByte* pData, TBase32 length, TBase32* pCount,
+                     TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pStream != (TStreamBuffer*)0), "");
+    KNL_ASSERT((pData != (TByte*)0), "");
+    KNL_ASSERT((pCount != (TBase32*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xStreamBufferSend(pStream, pData, length, pCount, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 线程/ISR从字节流缓冲区读取数据                                                         *
+ *  参数: (1) pStream    字节流缓冲区结构地址                                                    *
+ *        (2) pData      保存数据的地址                                                          *
+ *        (3) length     最多读取的字节数                                                        *
+ *        (4) pCount     实际读取的字节数                                                        *
+ *        (5) option     读取字节流的模式                                                        *
+ *        (6) timeo      时限阻塞模式下读取字节流的时限长度                                      *
+ *        (7) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：同一个字节流缓冲区只能有一个消费者                                                     *
+ *************************************************************************************************/
+TState TclReceiveStream(TStreamBuffer* pStream, TByte* pData, TBase32 length, TBase32* pCount,
+                        TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pStream != (TStreamBuffer*)0), "");
+    KNL_ASSERT((pData != (TByte*)0), "");
+    KNL_ASSERT((pCount != (TBase32*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_STREAM_OPTION;
+    state = xStreamBufferReceive(pStream, pData, length, pCount, option, timeo, pError);
+    return state;
+}
+#endif
+
+
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_MQUE_ENABLE) && (TCLC_IPC_PMQUE_ENABLE))
+/*************************************************************************************************
+ *  功能: 初始化多优先级消息队列                                                                 *
+ *  参数: (1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pName    消息队列的名称                                                            *
+ *        (3) pNodes   消息节点数组地址                                                          *
+ *        (4) capacity 消息队列容量，即消息节点数组大小                                          *
+ *        (5) property 消息队列的初始属性                                                        *
+ *        (6) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclCreatePrioMsgQueue(TPrioMsgQueue* pMsgQue, TChar* pName, TPrioMsgNode* pNodes,
+                             TBase32 capacity, TProperty property, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pMsgQue != (TPrioMsgQueue*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pNodes != (TPrioMsgNode*)0), "");
+    KNL_ASSERT((capacity > 0U), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    property &= IPC_USER_PMQUE_PROP;
+    state = xPMQCreate(pMsgQue, pName, pNodes, capacity, property, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 删除多优先级消息队列                                                                   *
+ *  参数: (1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：注意线程的等待结果都是TCLE_IPC_DELETE                                                  *
+ *************************************************************************************************/
+TState TclDeletePrioMsgQueue(TPrioMsgQueue* pMsgQue, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pMsgQue != (TPrioMsgQueue*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xPMQDelete(pMsgQue, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 用于线程/ISR向多优先级消息队列中发送消息                                               *
+ *  参数: (1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pMsg2    保存消息结构地址的指针变量                                                *
+ *        (3) priority 消息优先级，数值越小优先级越高                                            *
+ *        (4) option   访问消息队列的模式                                                        *
+ *        (5) timeo    时限阻塞模式下访问消息队列的时限长度                                      *
+ *        (6) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclSendPrioMessage(TPrioMsgQueue* pMsgQue, TMessage* pMsg2, TPriority priority,
+                          TOption option, TTimeTick timeo, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pMsgQue != (TPrioMsgQueue*)0), "");
+    KNL_ASSERT((pMsg2 != (TMessage*)0), "");
+    KNL_ASSERT((priority < TCLC_IPC_PMQUE_PRIORITY_NUM), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_PMQUE_OPTION;
+    state = xPMQSend(pMsgQue, pMsg2, priority, option, timeo, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能: 用于线程/ISR接收多优先级消息队列中优先级最高的消息                                     *
+ *  参数: (1) pMsgQue  消息队列结构地址                                                          *
+ *        (2) pMsg2    保存消息结构地址的指针变量                                                *
+ *        (3) option   访问消息队列的模式                                                        *
+ *        (4) timeo    时限阻塞模式下访问消息队列的时限长度                                      *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回: (1) eFailure 操作失败                                                                  *
+ *        (2) eSuccess 操作成功                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclReceivePrioMessage(TPrioMsgQueue* pMsgQue, TMessage* pMsg2, TOption option,
+                             TTimeTick timeo, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pMsgQue != (TPrioMsgQueue*)0), "");
+    KNL_ASSERT((pMsg2 != (TMessage*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_PMQUE_OPTION;
+    state = xPMQReceive(pMsgQue, pMsg2, option, timeo, pError);
+    return state;
+}
+#endif
+
+
+#if (TCLC_TIMER_ENABLE)
+/*************************************************************************************************
+ *  功能：用户定时器初始化函数                                                                   *
+ *  参数：(1) pTimer   定时器地址                                                                *
+ *        (2) pName    定时器名称                                                                *
+ *        (3) property 定时器属性                                                                *
+ *        (4) ticks    定时器滴答数目                                                            *
+ *        (5) pRoutine 用户定时器回调函数                                                        *
+ *        (6) pData    用户定时器回调函数参数                                                    *
+ *        (7) priority 定时器优先级                                                              *
+ *        (8) pError   详细调用结果                                                              *
+ *  返回: (1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：TCLP_TIMER_ISR定时器的回调函数在时钟节拍中断中执行，只能调用ISR接口                    *
+ *************************************************************************************************/
+TState TclCreateTimer(TTimer* pTimer, TChar* pName, TProperty property, TTimeTick ticks,
+                      TTimerRoutine pRoutine, TArgument data, TPriority priority, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTimer != (TTimer*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pRoutine != (TTimerRoutine)0), "");
+    KNL_ASSERT((ticks > 0U), "");
+    KNL_ASSERT((ticks < (TCLM_MAX_VALUE64 >> 1U)), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    property &= TIMER_USER_PROPERTY;
+    state = xTimerCreate(pTimer, pName, property, ticks, pRoutine, data, priority, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：内核定时器取消初始化                                                                   *
+ *  参数：(1) pTimer   定时器结构地址                                                            *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回: (1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明                                                                                         *
+ *************************************************************************************************/
+TState TclDeleteTimer(TTimer* pTimer, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTimer != (TTimer*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xTimerDelete(pTimer, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：定时器启动函数                                                                         *
+ *  参数：(1) pTimer     定时器结构地址                                                          *
+ *        (2) lagticks   定时器延缓开始计数时间                                                  *
+ *        (3) pError     详细调用结果                                                            *
+ *  返回: (1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：无                                                                                     *
+ *************************************************************************************************/
+TState TclStartTimer(TTimer* pTimer, TTimeTick lagticks, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTimer != (TTimer*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((lagticks < (TCLM_MAX_VALUE64 >> 1U)), "");
+
+    state = xTimerStart(pTimer, lagticks, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：停止用户定时器函数                                                                     *
+ *  参数：(1) pTimer   定时器地址                                                                *
+ *        (2) pError   详细调用结果                                                              * 
+ *  返回: (1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：                                                                                       * 
+ *************************************************************************************************/
+TState TclStopTimer(TTimer* pTimer, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTimer != (TTimer*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xTimerStop(pTimer, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：重置定时器类型、定时时间和优先级                                                       *
+ *  参数：(1) pTimer   定时器结构地址                                                            *
+ *        (2) ticks    定时器时钟节拍数目                                                        *
+ *        (3) priority 定时器优先级                                                              *
+ *        (4) slack    定时器允许延缓到时的节拍数目                                              *
+ *        (5) pError   详细调用结果                                                              *
+ *  返回: (1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：slack不为0时，内核会在允许的范围内调整定时器到时时刻，使相近的定时器在同一节拍到时     *
+ *************************************************************************************************/
+TState TclConfigTimer(TTimer* pTimer, TTimeTick ticks, TPriority priority, TTimeTick slack,
+                      TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTimer != (TTimer*)0), "");
+    KNL_ASSERT((ticks > 0U), "");
+    KNL_ASSERT((ticks < TCLM_MAX_VALUE32), "");
+    KNL_ASSERT((slack < ticks), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xTimerConfig(pTimer, ticks, priority, slack, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：获得定时器守护线程批处理统计数据                                                       *
+ *  参数：(1) pStats   返回批处理统计数据                                                        *
+ *  返回：无                                                                                     *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+void TclGetTimerBatchStats(TTimerBatchStats* pStats)
+{
+    KNL_ASSERT((pStats != (TTimerBatchStats*)0), "");
+    xTimerGetBatchStats(pStats);
+}
+
+
+#if (TCLC_TIMER_HRES_ENABLE)
+/*************************************************************************************************
+ *  功能：初始化高精度单次定时器                                                                 *
+ *  参数：(1) pTimer   高精度定时器结构地址                                                      *
+ *        (2) pRoutine 定时器回调函数                                                            *
+ *        (3) data     定时器回调函数参数                                                        *
+ *        (4) pError   详细调用结果                                                              *
+ *  返回: (1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：回调函数在硬件定时器中断中执行，只能调用ISR接口                                        *
+ *************************************************************************************************/
+TState TclInitHrTimer(THrTimer* pTimer, THrTimerRoutine pRoutine, TArgument data,
+                      TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTimer != (THrTimer*)0), "");
+    KNL_ASSERT((pRoutine != (THrTimerRoutine)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xTimerInitHres(pTimer, pRoutine, data, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：启动高精度单次定时器                                                                   *
+ *  参数：(1) pTimer   高精度定时器结构地址                                                      *
+ *        (2) usecs    定时器到时的微秒数                                                        *
+ *        (3) pError   详细调用结果                                                              *
+ *  返回: (1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：定时器必须先经过TclInitHrTimer初始化                                                   *
+ *************************************************************************************************/
+TState TclStartHrTimer(THrTimer* pTimer, TTimeStamp usecs, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTimer != (THrTimer*)0), "");
+    KNL_ASSERT((usecs > 0U), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xTimerStartHres(pTimer, usecs, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：停止高精度单次定时器                                                                   *
+ *  参数：(1) pTimer   高精度定时器结构地址                                                      *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回: (1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclStopHrTimer(THrTimer* pTimer, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTimer != (THrTimer*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xTimerStopHres(pTimer, pError);
+    return state;
+}
+#endif
+#endif
+
+
+#if ((TCLC_IRQ_ENABLE) && (TCLC_IRQ_DAEMON_ENABLE))
+/*************************************************************************************************
+ *  功能：提交中断请求                                                                           *
+ *  参数：(1) pIRQ      中断请求结构地址                                                         *
+ *        (2) pEntry    中断处理回调函数                                                         *
+ *        (3) data      中断处理回调参数                                                         *
+ *        (4) priority  中断请求优先级                                                           *
+ *        (5) pError    详细调用结果                                                             *
+ *  返回: (1) eFailure  操作失败                                                                 *
+ *        (2) eSuccess  操作成功                                                                 *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclPostIRQ(TIrq* pIRQ, TIrqEntry pEntry, TArgument data, TPriority priority, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pIRQ != (TIrq*)0), "");
+
+    state = xIrqPostRequest(pIRQ, pEntry, data, priority, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：撤销中断请求                                                                           *
+ *  参数：(1) TIrq      中断请求结构地址                                                         *
+ *        (2) pError    详细调用结果                                                             * 
+ *  返回: (1) eFailure  操作失败                                                                 *
+ *        (2) eSuccess  操作成功                                                                 *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclCancelIRQ(TIrq* pIRQ, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pIRQ != (TIrq*)0), "");
+
+    state = xIrqCancelRequest(pIRQ, pError);
+    return state;
+}
+#endif
+
+
+#if ((TCLC_COROUTINE_ENABLE) && (TCLC_IPC_ENABLE) && (TCLC_IPC_SEMAPHORE_ENABLE))
+/*************************************************************************************************
+ *  功能：初始化协程调度器                                                                       *
+ *  参数：(1) pScheduler 协程调度器结构地址                                                      *
+ *        (2) pName      协程调度器名称                                                          *
+ *        (3) ticks      等待条件的协程的轮询周期，为0时只在调度器被唤醒时重新检查条件           *
+ *        (4) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclCreateCoScheduler(TCoScheduler* pScheduler, TChar* pName, TTimeTick ticks,
+                            TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pScheduler != (TCoScheduler*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((ticks < TCLM_MAX_VALUE32), "");
 
-    /* 调整操作选项，屏蔽不需要支持的选项 */
-    option &= IPC_USER_FLAG_OPTION;
-    state = xFlagsReceive(pFlags, pPattern, option, timeo, pError);
+    state = xCoSchedulerCreate(pScheduler, pName, ticks, pError);
     return state;
 }
 
 
 /*************************************************************************************************
- *  功能: 清除事件标记阻塞队列                                                                   *
- *  参数：(1) pFlags   事件标记的地址                                                            *
- *        (2) pError   详细调用结果                                                              *
- *  返回: (1) eFailure   操作失败                                                                *
- *        (2) eSuccess   操作成功                                                                *
- *  说明：                                                                                       *
+ *  功能：唤醒协程调度器                                                                         *
+ *  参数：(1) pScheduler 协程调度器结构地址                                                      *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：线程、ISR和定时器回调函数都可以调用，使等待条件的协程立即重新检查条件                  *
  *************************************************************************************************/
-TState TclResetFlags(TFlags* pFlags, TError* pError)
+TState TclWakeCoScheduler(TCoScheduler* pScheduler, TError* pError)
 {
     TState state;
-
-    KNL_ASSERT((pFlags != (TFlags*)0), "");
+    KNL_ASSERT((pScheduler != (TCoScheduler*)0), "");
     KNL_ASSERT((pError != (TError*)0), "");
 
-    state = xFlagsReset(pFlags, pError);
+    state = xCoSchedulerWake(pScheduler, pError);
     return state;
 }
 
 
 /*************************************************************************************************
- *  功能：事件标记终止函数,将指定的线程从事件标记的线程阻塞队列中终止阻塞并唤醒                  *
- *  参数：(1) pFlags   事件标记结构地址                                                          *
- *        (2) option   参数选项                                                                  *
- *        (3) pThread  线程地址                                                                  *
- *        (4) pError   详细调用结果                                                              *
- *  返回：(1) eSuccess                                                                           *
- *        (2) eFailure                                                                           *
- *  说明：                                                                                       *
+ *  功能：运行协程调度器                                                                         *
+ *  参数：(1) pScheduler 协程调度器结构地址                                                      *
+ *  返回：无                                                                                     *
+ *  说明：在宿主线程的线程函数中调用，本函数不会返回                                             *
  *************************************************************************************************/
-TState TclFlushFlags(TFlags* pFlags, TError* pError)
+void TclRunCoScheduler(TCoScheduler* pScheduler)
 {
-    TState state = eFailure;
-    KNL_ASSERT((pFlags != (TFlags*)0), "");
+    KNL_ASSERT((pScheduler != (TCoScheduler*)0), "");
+
+    xCoSchedulerRun(pScheduler);
+}
+
+
+/*************************************************************************************************
+ *  功能：启动协程                                                                               *
+ *  参数：(1) pScheduler 协程调度器结构地址                                                      *
+ *        (2) pCoroutine 协程结构地址                                                            *
+ *        (3) pEntry     协程函数                                                                *
+ *        (4) data       协程函数参数                                                            *
+ *        (5) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：协程函数在宿主线程中运行，等待IPC时只能使用非阻塞的IPC操作，例如：                     *
+ *        TCLM_CO_WAIT_UNTIL(pCo, TclObtainSemaphore(&sem, TCLO_IPC_DEFAULT, 0, &err)            *
+ *        == eSuccess)                                                                           *
+ *************************************************************************************************/
+TState TclSpawnCoroutine(TCoScheduler* pScheduler, TCoroutine* pCoroutine,
+                         TCoroutineEntry pEntry, TArgument data, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pScheduler != (TCoScheduler*)0), "");
+    KNL_ASSERT((pCoroutine != (TCoroutine*)0), "");
+    KNL_ASSERT((pEntry != (TCoroutineEntry)0), "");
     KNL_ASSERT((pError != (TError*)0), "");
 
-    state = xFlagsFlush(pFlags, pError);
+    state = xCoroutineSpawn(pScheduler, pCoroutine, pEntry, data, pError);
     return state;
 }
 #endif
 
 
-#if (TCLC_TIMER_ENABLE)
+#if (TCLC_TASK_ENABLE)
 /*************************************************************************************************
- *  功能：用户定时器初始化函数                                                                   *
- *  参数：(1) pTimer   定时器地址                                                                *
- *        (2) pName    定时器名称                                                                *
- *        (3) property 定时器属性                                                                *
- *        (4) ticks    定时器滴答数目                                                            *
- *        (5) pRoutine 用户定时器回调函数                                                        *
- *        (6) pData    用户定时器回调函数参数                                                    *
- *        (7) priority 定时器优先级                                                              *
- *        (8) pError   详细调用结果                                                              *
- *  返回: (1) eSuccess 操作成功                                                                  *
- *        (2) eFailure 操作失败                                                                  *
- *  说明                                                                                         *
+ *  功能：初始化任务级别                                                                         *
+ *  参数：(1) pLevel     任务级别结构地址                                                        *
+ *        (2) pName      任务级别名称                                                            *
+ *        (3) pStack     该级别全部任务共用的线程栈地址                                          *
+ *        (4) bytes      线程栈大小，以字节为单位                                                *
+ *        (5) priority   宿主线程优先级，也就是该级别全部任务的抢占级别                          *
+ *        (6) ticks      宿主线程时间片长度                                                      *
+ *        (7) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：同一级别的任务依次运行到完成，彼此之间不会抢占，所以可以共用一个线程栈                 *
  *************************************************************************************************/
-TState TclCreateTimer(TTimer* pTimer, TChar* pName, TProperty property, TTimeTick ticks,
-                      TTimerRoutine pRoutine, TArgument data, TPriority priority, TError* pError)
+TState TclCreateTaskLevel(TTaskLevel* pLevel, TChar* pName, void* pStack, TBase32 bytes,
+                          TPriority priority, TTimeTick ticks, TError* pError)
 {
     TState state;
-    KNL_ASSERT((pTimer != (TTimer*)0), "");
+    KNL_ASSERT((pLevel != (TTaskLevel*)0), "");
     KNL_ASSERT((pName != (TChar*)0), "");
-    KNL_ASSERT((pRoutine != (TTimerRoutine)0), "");
+    KNL_ASSERT((pStack != (void*)0), "");
+    KNL_ASSERT((bytes > 0U), "");
+    KNL_ASSERT((priority <= TCLC_USER_PRIORITY_LOW), "");
+    KNL_ASSERT((priority >= TCLC_USER_PRIORITY_HIGH), "");
     KNL_ASSERT((ticks > 0U), "");
-    KNL_ASSERT((ticks < (TCLM_MAX_VALUE64 >> 1U)), "");
     KNL_ASSERT((pError != (TError*)0), "");
 
-    property &= TIMER_USER_PROPERTY;
-    state = xTimerCreate(pTimer, pName, property, ticks, pRoutine, data, priority, pError);
+    state = xTaskLevelCreate(pLevel, pName, pStack, bytes, priority, ticks, pError);
     return state;
 }
 
 
 /*************************************************************************************************
- *  功能：内核定时器取消初始化                                                                   *
- *  参数：(1) pTimer   定时器结构地址                                                            *
- *        (2) pError   详细调用结果                                                              *
- *  返回: (1) eSuccess 操作成功                                                                  *
- *        (2) eFailure 操作失败                                                                  *
- *  说明                                                                                         *
+ *  功能：初始化运行到完成任务                                                                   *
+ *  参数：(1) pTask       任务结构地址                                                           *
+ *        (2) pLevel      任务所属的任务级别                                                     *
+ *        (3) pEntry      任务函数                                                               *
+ *        (4) data        任务函数参数                                                           *
+ *        (5) priority    任务在级别内的优先级，数值越小越先运行                                 *
+ *        (6) activations 任务允许挂起的最大激活次数                                             *
+ *        (7) pError      详细调用结果                                                           *
+ *  返回：(1) eSuccess    操作成功                                                               *
+ *        (2) eFailure    操作失败                                                               *
+ *  说明：                                                                                       *
  *************************************************************************************************/
-TState TclDeleteTimer(TTimer* pTimer, TError* pError)
+TState TclCreateTask(TTask* pTask, TTaskLevel* pLevel, TTaskEntry pEntry, TArgument data,
+                     TPriority priority, TBase32 activations, TError* pError)
 {
     TState state;
-    KNL_ASSERT((pTimer != (TTimer*)0), "");
+    KNL_ASSERT((pTask != (TTask*)0), "");
+    KNL_ASSERT((pLevel != (TTaskLevel*)0), "");
+    KNL_ASSERT((pEntry != (TTaskEntry)0), "");
+    KNL_ASSERT((activations > 0U), "");
     KNL_ASSERT((pError != (TError*)0), "");
 
-    state = xTimerDelete(pTimer, pError);
+    state = xTaskCreate(pTask, pLevel, pEntry, data, priority, activations, pError);
     return state;
 }
 
 
 /*************************************************************************************************
- *  功能：定时器启动函数                                                                         *
- *  参数：(1) pTimer     定时器结构地址                                                          *
- *        (2) lagticks   定时器延缓开始计数时间                                                  *
- *        (3) pError     详细调用结果                                                            *
- *  返回: (1) eSuccess   操作成功                                                                *
+ *  功能：激活运行到完成任务                                                                     *
+ *  参数：(1) pTask      任务结构地址                                                            *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
  *        (2) eFailure   操作失败                                                                *
- *  说明：无                                                                                     *
+ *  说明：线程和ISR都可以调用                                                                    *
  *************************************************************************************************/
-TState TclStartTimer(TTimer* pTimer, TTimeTick lagticks, TError* pError)
+TState TclActivateTask(TTask* pTask, TError* pError)
 {
     TState state;
-    KNL_ASSERT((pTimer != (TTimer*)0), "");
+    KNL_ASSERT((pTask != (TTask*)0), "");
     KNL_ASSERT((pError != (TError*)0), "");
-    KNL_ASSERT((lagticks < (TCLM_MAX_VALUE64 >> 1U)), "");
 
-    state = xTimerStart(pTimer, lagticks, pError);
+    state = xTaskActivate(pTask, pError);
     return state;
 }
+#endif
 
 
+#if ((TCLC_WORKQUEUE_ENABLE) && (TCLC_TIMER_ENABLE))
 /*************************************************************************************************
- *  功能：停止用户定时器函数                                                                     *
- *  参数：(1) pTimer   定时器地址                                                                *
- *        (2) pError   详细调用结果                                                              * 
- *  返回: (1) eSuccess 操作成功                                                                  *
- *        (2) eFailure 操作失败                                                                  *
- *  说明：                                                                                       * 
+ *  功能：初始化工作队列和工作线程池                                                             *
+ *  参数：(1) pQueue     工作队列结构地址                                                        *
+ *        (2) pName      工作队列名称                                                            *
+ *        (3) pStack     全部工作线程的栈空间地址，大小为workers * bytes                         *
+ *        (4) bytes      每个工作线程的栈大小，以字节为单位                                      *
+ *        (5) workers    工作线程数目                                                            *
+ *        (6) priority   工作线程优先级                                                          *
+ *        (7) ticks      工作线程时间片长度                                                      *
+ *        (8) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
  *************************************************************************************************/
-TState TclStopTimer(TTimer* pTimer, TError* pError)
+TState TclCreateWorkQueue(TWorkQueue* pQueue, TChar* pName, void* pStack, TBase32 bytes,
+                          TBase32 workers, TPriority priority, TTimeTick ticks, TError* pError)
 {
     TState state;
-    KNL_ASSERT((pTimer != (TTimer*)0), "");
+    KNL_ASSERT((pQueue != (TWorkQueue*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pStack != (void*)0), "");
+    KNL_ASSERT((bytes > 0U), "");
+    KNL_ASSERT((workers > 0U), "");
+    KNL_ASSERT((workers <= TCLC_WORKQUEUE_WORKER_NUM), "");
+    KNL_ASSERT((priority <= TCLC_USER_PRIORITY_LOW), "");
+    KNL_ASSERT((priority >= TCLC_USER_PRIORITY_HIGH), "");
+    KNL_ASSERT((ticks > 0U), "");
     KNL_ASSERT((pError != (TError*)0), "");
 
-    state = xTimerStop(pTimer, pError);
+    state = xWorkQueueCreate(pQueue, pName, pStack, bytes, workers, priority, ticks, pError);
     return state;
 }
 
 
 /*************************************************************************************************
- *  功能：重置定时器类型、定时时间和优先级                                                       *
- *  参数：(1) pTimer   定时器结构地址                                                            *
- *        (2) ticks    定时器时钟节拍数目                                                        *
- *        (3) priority 定时器优先级                                                              *
- *        (4) pError   详细调用结果                                                              *
- *  返回: (1) eSuccess 操作成功                                                                  *
- *        (2) eFailure 操作失败                                                                  *
- *  说明                                                                                         *
+ *  功能：初始化工作项                                                                           *
+ *  参数：(1) pItem      工作项结构地址                                                          *
+ *        (2) pName      工作项名称                                                              *
+ *        (3) pQueue     工作项所属的工作队列                                                    *
+ *        (4) pEntry     工作函数                                                                *
+ *        (5) data       工作函数参数                                                            *
+ *        (6) priority   工作项优先级，数值越小越先执行                                          *
+ *        (7) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：                                                                                       *
  *************************************************************************************************/
-TState TclConfigTimer(TTimer* pTimer, TTimeTick ticks, TPriority priority, TError* pError)
+TState TclCreateWorkItem(TWorkItem* pItem, TChar* pName, TWorkQueue* pQueue, TWorkEntry pEntry,
+                         TArgument data, TPriority priority, TError* pError)
 {
     TState state;
-    KNL_ASSERT((pTimer != (TTimer*)0), "");
-    KNL_ASSERT((ticks > 0U), "");
-    KNL_ASSERT((ticks < TCLM_MAX_VALUE32), "");
+    KNL_ASSERT((pItem != (TWorkItem*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pQueue != (TWorkQueue*)0), "");
+    KNL_ASSERT((pEntry != (TWorkEntry)0), "");
+    KNL_ASSERT((priority < TCLC_WORKQUEUE_PRIORITY_NUM), "");
     KNL_ASSERT((pError != (TError*)0), "");
 
-    state = xTimerConfig(pTimer, ticks, priority, pError);
+    state = xWorkItemCreate(pItem, pName, pQueue, pEntry, data, priority, pError);
     return state;
 }
-#endif
 
 
-#if ((TCLC_IRQ_ENABLE) && (TCLC_IRQ_DAEMON_ENABLE))
 /*************************************************************************************************
- *  功能：提交中断请求                                                                           *
- *  参数：(1) pIRQ      中断请求结构地址                                                         *
- *        (2) pEntry    中断处理回调函数                                                         *
- *        (3) data      中断处理回调参数                                                         *
- *        (4) priority  中断请求优先级                                                           *
- *        (5) pError    详细调用结果                                                             *
- *  返回: (1) eFailure  操作失败                                                                 *
- *        (2) eSuccess  操作成功                                                                 *
- *  说明：                                                                                       *
+ *  功能：提交工作项                                                                             *
+ *  参数：(1) pItem      工作项结构地址                                                          *
+ *        (2) ticks      延时提交的节拍数，为0时立即提交                                         *
+ *        (3) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：线程和ISR都可以调用                                                                    *
  *************************************************************************************************/
-TState TclPostIRQ(TIrq* pIRQ, TIrqEntry pEntry, TArgument data, TPriority priority, TError* pError)
+TState TclSubmitWorkItem(TWorkItem* pItem, TTimeTick ticks, TError* pError)
 {
     TState state;
-    KNL_ASSERT((pIRQ != (TIrq*)0), "");
+    KNL_ASSERT((pItem != (TWorkItem*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((ticks < TCLM_MAX_VALUE32), "");
 
-    state = xIrqPostRequest(pIRQ, pEntry, data, priority, pError);
+    state = xWorkItemSubmit(pItem, ticks, pError);
     return state;
 }
 
 
 /*************************************************************************************************
- *  功能：撤销中断请求                                                                           *
- *  参数：(1) TIrq      中断请求结构地址                                                         *
- *        (2) pError    详细调用结果                                                             * 
- *  返回: (1) eFailure  操作失败                                                                 *
- *        (2) eSuccess  操作成功                                                                 *
- *  说明：                                                                                       *
+ *  功能：取消工作项                                                                             *
+ *  参数：(1) pItem      工作项结构地址                                                          *
+ *        (2) pError     详细调用结果                                                            *
+ *  返回：(1) eSuccess   操作成功                                                                *
+ *        (2) eFailure   操作失败                                                                *
+ *  说明：线程和ISR都可以调用，正在执行的工作项不能被取消                                        *
  *************************************************************************************************/
-TState TclCancelIRQ(TIrq* pIRQ, TError* pError)
+TState TclCancelWorkItem(TWorkItem* pItem, TError* pError)
 {
     TState state;
-    KNL_ASSERT((pIRQ != (TIrq*)0), "");
+    KNL_ASSERT((pItem != (TWorkItem*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
 
-    state = xIrqCancelRequest(pIRQ, pError);
+    state = xWorkItemCancel(pItem, pError);
     return state;
 }
 #endif
@@ -1461,6 +2928,191 @@ TState TclFreePoolMemory(TMemPool* pPool, void* pAddr, TError* pError)
 #endif
 
 
+#if ((TCLC_IPC_ENABLE) && (TCLC_IPC_PUBSUB_ENABLE) && (TCLC_MEMORY_ENABLE) && (TCLC_MEMORY_POOL_ENABLE))
+/*************************************************************************************************
+ *  功能：初始化主题                                                                             *
+ *  参数：(1) pTopic   主题结构地址                                                              *
+ *        (2) pName    主题名称                                                                  *
+ *        (3) pPool    数据缓冲区所在的内存池                                                    *
+ *        (4) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclCreateTopic(TTopic* pTopic, TChar* pName, TMemPool* pPool, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTopic != (TTopic*)0), "");
+    KNL_ASSERT((pName != (TChar*)0), "");
+    KNL_ASSERT((pPool != (TMemPool*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xTopicCreate(pTopic, pName, pPool, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：删除主题                                                                               *
+ *  参数：(1) pTopic   主题结构地址                                                              *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclDeleteTopic(TTopic* pTopic, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTopic != (TTopic*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xTopicDelete(pTopic, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：订阅主题                                                                               *
+ *  参数：(1) pTopic   主题结构地址                                                              *
+ *        (2) pSub     订阅者结构地址                                                            *
+ *        (3) pSlots   订阅者数据槽位数组地址                                                    *
+ *        (4) depth    槽位数目                                                                  *
+ *        (5) property 订阅者属性，TCLP_IPC_OVERWRITE表示队列满时丢弃最早的数据                  *
+ *        (6) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclSubscribeTopic(TTopic* pTopic, TSubscriber* pSub, void** pSlots, TBase32 depth,
+                         TProperty property, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTopic != (TTopic*)0), "");
+    KNL_ASSERT((pSub != (TSubscriber*)0), "");
+    KNL_ASSERT((pSlots != (void**)0), "");
+    KNL_ASSERT((depth > 0U), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    property &= IPC_USER_TOPIC_PROP;
+    state = xTopicSubscribe(pTopic, pSub, pSlots, depth, property, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：取消订阅主题                                                                           *
+ *  参数：(1) pSub     订阅者结构地址                                                            *
+ *        (2) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclUnsubscribeTopic(TSubscriber* pSub, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pSub != (TSubscriber*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xTopicUnsubscribe(pSub, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：从主题的内存池中借出一个数据缓冲区                                                     *
+ *  参数：(1) pTopic   主题结构地址                                                              *
+ *        (2) pData2   保存数据地址的指针变量                                                    *
+ *        (3) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclLoanTopicBuffer(TTopic* pTopic, void** pData2, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTopic != (TTopic*)0), "");
+    KNL_ASSERT((pData2 != (void**)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xTopicLoan(pTopic, pData2, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：向主题的全部订阅者发布数据                                                             *
+ *  参数：(1) pTopic   主题结构地址                                                              *
+ *        (2) pData    借出的数据缓冲区地址                                                      *
+ *        (3) length   数据长度                                                                  *
+ *        (4) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：发布之后生产者不能再访问该缓冲区                                                       *
+ *************************************************************************************************/
+TState TclPublishTopic(TTopic* pTopic, void* pData, TBase32 length, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTopic != (TTopic*)0), "");
+    KNL_ASSERT((pData != (void*)0), "");
+    KNL_ASSERT((length + sizeof(TTopicBuffer) <= pTopic->Pool->PageSize), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xTopicPublish(pTopic, pData, length, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：订阅者接收主题数据                                                                     *
+ *  参数：(1) pSub     订阅者结构地址                                                            *
+ *        (2) pData2   保存数据地址的指针变量                                                    *
+ *        (3) pLength  保存数据长度的变量                                                        *
+ *        (4) option   访问订阅者的模式                                                          *
+ *        (5) timeo    时限阻塞模式下等待数据的时限长度                                          *
+ *        (6) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：数据用完后必须调用TclReleaseTopicBuffer                                                *
+ *************************************************************************************************/
+TState TclReceiveTopic(TSubscriber* pSub, void** pData2, TBase32* pLength, TOption option,
+                       TTimeTick timeo, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pSub != (TSubscriber*)0), "");
+    KNL_ASSERT((pData2 != (void**)0), "");
+    KNL_ASSERT((pLength != (TBase32*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+    KNL_ASSERT((timeo < TCLM_MAX_VALUE32), "");
+
+    /* 调整操作选项，屏蔽不需要支持的选项 */
+    option &= IPC_USER_TOPIC_OPTION;
+    state = xTopicReceive(pSub, pData2, pLength, option, timeo, pError);
+    return state;
+}
+
+
+/*************************************************************************************************
+ *  功能：释放数据缓冲区的引用                                                                   *
+ *  参数：(1) pTopic   主题结构地址                                                              *
+ *        (2) pData    数据地址                                                                  *
+ *        (3) pError   详细调用结果                                                              *
+ *  返回：(1) eSuccess 操作成功                                                                  *
+ *        (2) eFailure 操作失败                                                                  *
+ *  说明：                                                                                       *
+ *************************************************************************************************/
+TState TclReleaseTopicBuffer(TTopic* pTopic, void* pData, TError* pError)
+{
+    TState state;
+    KNL_ASSERT((pTopic != (TTopic*)0), "");
+    KNL_ASSERT((pData != (void*)0), "");
+    KNL_ASSERT((pError != (TError*)0), "");
+
+    state = xTopicRelease(pTopic, pData, pError);
+    return state;
+}
+#endif
+
+
 #if ((TCLC_MEMORY_ENABLE) && (TCLC_MEMORY_BUDDY_ENABLE))
 /*************************************************************************************************
  *  功能：初始化伙伴内存管理控制结构                                                             *